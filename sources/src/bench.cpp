@@ -0,0 +1,779 @@
+/*
+Rodent, a UCI chess playing engine derived from Sungorus 1.4
+Copyright (C) 2009-2011 Pablo Vazquez (Sungorus author)
+Copyright (C) 2011-2018 Pawel Koziol
+
+Rodent is free software: you can redistribute it and/or modify it under the terms of the GNU
+General Public License as published by the Free Software Foundation, either version 3 of the
+License, or (at your option) any later version.
+
+Rodent is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program.
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "rodent.h"
+#include "book.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <vector>
+
+static const char *const bench_positions[] = {
+    "r1bqkbnr/pp1ppppp/2n5/2p5/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq -",       // 1.e4 c5 2.Nf3 Nc6
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -",   // multiple captures
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - -",                              // rook endgame
+    "4rrk1/pp1n3p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/4RRK1 b - - 7 19",
+    "rq3rk1/ppp2ppp/1bnpb3/3N2B1/3NP3/7P/PPPQ1PP1/2KR3R w - - 7 14",      // knight pseudo-sack
+    "r1bq1r1k/1pp1n1pp/1p1p4/4p2Q/4Pp2/1BNP4/PPP2PPP/3R1RK1 w - - 2 14",  // pawn chain
+    "r3r1k1/2p2ppp/p1p1bn2/8/1q2P3/2NPQN2/PPP3PP/R4RK1 b - - 2 15",
+    "r1bbk1nr/pp3p1p/2n5/1N4p1/2Np1B2/8/PPP2PPP/2KR1B1R w kq - 0 13",
+    "r1bq1rk1/ppp1nppp/4n3/3p3Q/3P4/1BP1B3/PP1N2PP/R4RK1 w - - 1 16",     // attack for pawn
+    "4r1k1/r1q2ppp/ppp2n2/4P3/5Rb1/1N1BQ3/PPP3PP/R5K1 w - - 1 17",        // exchange sack
+    "2rqkb1r/ppp2p2/2npb1p1/1N1Nn2p/2P1PP2/8/PP2B1PP/R1BQK2R b KQ - 0 11",
+    "r1bq1r1k/b1p1npp1/p2p3p/1p6/3PP3/1B2NN2/PP3PPP/R2Q1RK1 w - - 1 16",  // white pawn center
+    "3r1rk1/p5pp/bpp1pp2/8/q1PP1P2/b3P3/P2NQRPP/1R2B1K1 b - - 6 22",
+    "r1q2rk1/2p1bppp/2Pp4/p6b/Q1PNp3/4B3/PP1R1PPP/2K4R w - - 2 18",
+    "4k2r/1pb2ppp/1p2p3/1R1p4/3P4/2r1PN2/P4PPP/1R4K1 b - - 3 22",         // endgame
+    "3q2k1/pb3p1p/4pbp1/2r5/PpN2N2/1P2P2P/5PP1/Q2R2K1 b - - 4 26",        // both queens en prise
+    NULL
+}; // test positions taken from DiscoCheck by Lucas Braesch
+
+void cEngine::Bench(int depth) {
+
+    POS p[1];
+    int pv[MAX_PLY];
+
+    if (depth == 0) depth = 8; // so that you can call bench without parameters
+    Trans.Clear();
+    AllocEvalHash();
+    AllocPawnHash();
+    AllocMaterialHash();
+    ClearAll();
+    mDpCompleted = 0; // maybe move to ClearAll()?
+    Par.shut_up = true;
+
+    printf("Bench test started (depth %d): \n", depth);
+
+    Glob.nodes = 0;
+    Glob.abort_search = false;
+    msStartTime = GetMS();
+    msSearchDepth = depth;
+
+    // search each position to desired depth
+
+    for (int i = 0; bench_positions[i]; ++i) {
+        printf("%s\n", bench_positions[i]);
+        p->SetPosition(bench_positions[i]);
+        Par.InitAsymmetric(p);
+        Glob.depth_reached = 0;
+        Iterate(p, pv);
+    }
+
+    // calculate and print statistics
+
+    int end_time = GetMS() - msStartTime;
+    unsigned int nps = (unsigned int)((Glob.nodes * 1000) / (end_time + 1));
+
+    printf("eval hash %d KB: %" PRIu64 " probes, %.1f%% hits\n", mEvalHashKb, mEvalHashProbes,
+           mEvalHashProbes ? 100.0 * mEvalHashHits / mEvalHashProbes : 0.0);
+    printf("pawn hash %s: %" PRIu64 " probes, %.1f%% hits\n", SharedPawnTT.Enabled() ? "shared" : "per-thread", mPawnHashProbes,
+           mPawnHashProbes ? 100.0 * mPawnHashHits / mPawnHashProbes : 0.0);
+#ifdef USE_LAZY_EVAL_STATS
+    printf("lazy eval margin %d: %" PRIu64 " exits, %" PRIu64 " wrong (%.2f%%)\n", LAZY_MARGIN, mLazyExits, mLazyErrors,
+           mLazyExits ? 100.0 * mLazyErrors / mLazyExits : 0.0);
+#endif
+    printf("%" PRIu64 " nodes searched in %d, speed %u nps (Score: %.3f)\n", (U64)Glob.nodes, end_time, nps, (float)nps / 430914.0);
+}
+
+// Eval micro-benchmark: evaluates the bench positions and all positions one legal
+// move away from them `reps` times in a few configurations and prints the time per
+// call, so that the cost of king attack eval can be seen in isolation. Eval hash is off here; pawn hash, which holds king shelter, is on.
+
+void cEngine::EvalBench(int reps) {
+
+    POS p[1];
+    UNDO u[1];
+    eData e;
+    int list[MAX_MOVES];
+    std::vector<POS> positions;
+
+    if (reps == 0) reps = 200;
+    mEvalTT.reset();        // eval hash off, AllocEvalHash() restores it before next search
+    mEvalHashMask = 0;
+    mEvalHashKb = 0;
+    AllocPawnHash();
+    AllocMaterialHash();
+    ClearAll();
+
+    for (int i = 0; bench_positions[i]; ++i) {
+        p->SetPosition(bench_positions[i]);
+        positions.push_back(*p);
+
+        int *last = p->GenerateCaptures(list);
+        last = p->GenerateQuiet(last);
+
+        for (int *move = list; move < last; move++) {
+            p->DoMove(*move, u);
+            if (!p->Illegal()) positions.push_back(*p);
+            p->UndoMove(*move, u);
+        }
+    }
+
+    p->SetPosition(bench_positions[0]);
+    Par.InitAsymmetric(p);
+
+    enum { EB_NO_KING_ATT, EB_KING_ATT, EB_CNT };
+    const char *names[] = { "king attack skipped", "king attack computed" };
+    const int skip[2] = { Par.skip_terms[WC], Par.skip_terms[BC] };
+    double best[EB_CNT];
+    int checksum = 0;
+
+    printf("Eval micro-benchmark: %d positions, %d reps\n", (int)positions.size(), reps);
+
+    // modes are interleaved and the best of several rounds is kept to filter out noise
+
+    for (int round = 0; round < 5; round++) {
+        for (int mode = EB_NO_KING_ATT; mode < EB_CNT; mode++) {
+
+            for (eColor sd = WC; sd < 2; ++sd) {
+                Par.skip_terms[sd] = skip[sd];
+                if (mode == EB_NO_KING_ATT) Par.skip_terms[sd] |= ET_KING_ATT;
+            }
+
+            for (POS &pos : positions)    // warm up pawn hash
+                checksum += Evaluate(&pos, &e);
+
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < reps; i++)
+                for (POS &pos : positions)
+                    checksum += Evaluate(&pos, &e);
+            auto end = std::chrono::steady_clock::now();
+
+            double ns = std::chrono::duration<double, std::nano>(end - start).count() / ((double)reps * positions.size());
+            if (round == 0 || ns < best[mode]) best[mode] = ns;
+        }
+    }
+
+    for (int mode = EB_NO_KING_ATT; mode < EB_CNT; mode++)
+        printf("%-28s %7.1f ns/eval\n", names[mode], best[mode]);
+
+    // move generation on the same positions, mostly slider attack lookups
+
+    double best_gen = 0.0;
+    for (int round = 0; round < 5; round++) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < reps; i++)
+            for (POS &pos : positions)
+                checksum += (int)(pos.GenerateQuiet(pos.GenerateCaptures(list)) - list);
+        auto end = std::chrono::steady_clock::now();
+
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / ((double)reps * positions.size());
+        if (round == 0 || ns < best_gen) best_gen = ns;
+    }
+    printf("%-28s %7.1f ns/position\n", "move generation", best_gen);
+
+    for (eColor sd = WC; sd < 2; ++sd)
+        Par.skip_terms[sd] = skip[sd];
+    ClearAll();
+    printf_debug("checksum %d\n", checksum);
+}
+
+#ifdef MICROBENCH
+
+// Component micro-benchmarks, built by `make microbench`: move generation, make/unmake,
+// eval with a cold and a hot eval hash, Swap(), transposition table store/retrieve and
+// book probes, each timed on its own over a fixed set of positions (the bench positions
+// and all positions up to two legal moves away from them). Every repetition runs all
+// components once, interleaved so that the machine slowing down affects them alike,
+// and the mean, standard deviation and minimum time per call over repetitions are
+// printed. The first repetition only warms up caches and is not counted.
+
+struct sMicroStat {
+    const char *name;
+    U64 ops;                    // calls per repetition
+    std::vector<double> ns;     // time per call in each repetition
+};
+
+template<typename tBody>
+static void MicroTime(sMicroStat *stat, bool keep, tBody body) {
+
+    auto start = std::chrono::steady_clock::now();
+    stat->ops = body();
+    auto end = std::chrono::steady_clock::now();
+
+    if (keep && stat->ops)
+        stat->ns.push_back(std::chrono::duration<double, std::nano>(end - start).count() / stat->ops);
+}
+
+static void PrintMicroStat(const sMicroStat *stat) {
+
+    if (stat->ns.empty()) {
+        printf("%-24s %10s\n", stat->name, "skipped");
+        return;
+    }
+
+    double sum = 0.0, sq_sum = 0.0, min = stat->ns[0];
+    for (double ns : stat->ns) {
+        sum += ns;
+        sq_sum += ns * ns;
+        if (ns < min) min = ns;
+    }
+    const double n = (double)stat->ns.size();
+    const double mean = sum / n;
+    const double sd = n > 1 ? sqrt(std::max(0.0, (sq_sum - n * mean * mean) / (n - 1))) : 0.0;
+
+    printf("%-24s %10" PRIu64 " %9.1f %8.1f %6.1f%% %9.1f\n", stat->name, stat->ops, mean, sd,
+           mean > 0.0 ? 100.0 * sd / mean : 0.0, min);
+}
+
+void cEngine::MicroBench(int reps) {
+
+    POS p[1];
+    UNDO u[1];
+    eData e;
+    int list[MAX_MOVES];
+    std::vector<POS> positions;
+    std::vector<int> moves, captures;           // pseudo-legal moves of all positions, back to back
+    std::vector<size_t> moves_end, captures_end;
+
+    if (reps <= 0) reps = 10;
+
+    // fixed position set: bench positions and their legal children and grandchildren
+
+    for (int i = 0; bench_positions[i]; ++i) {
+        p->SetPosition(bench_positions[i]);
+        positions.push_back(*p);
+
+        int *last = p->GenerateQuiet(p->GenerateCaptures(list));
+        for (int *move = list; move < last; move++) {
+            p->DoMove(*move, u);
+            if (!p->Illegal()) {
+                POS child[1];
+                int child_list[MAX_MOVES];
+                UNDO child_u[1];
+
+                *child = *p;
+                positions.push_back(*child);
+
+                int *child_last = child->GenerateQuiet(child->GenerateCaptures(child_list));
+                for (int *reply = child_list; reply < child_last; reply++) {
+                    child->DoMove(*reply, child_u);
+                    if (!child->Illegal()) positions.push_back(*child);
+                    child->UndoMove(*reply, child_u);
+                }
+            }
+            p->UndoMove(*move, u);
+        }
+    }
+
+    for (POS &pos : positions) {
+        int *last = pos.GenerateCaptures(list);
+        captures.insert(captures.end(), list, last);
+        captures_end.push_back(captures.size());
+        last = pos.GenerateQuiet(last);
+        moves.insert(moves.end(), list, last);
+        moves_end.push_back(moves.size());
+    }
+
+    // tables as the first search would find them
+
+    Trans.AllocTrans(16);
+    AllocEvalHash();
+    AllocPawnHash();
+    AllocMaterialHash();
+    ClearAll();
+    p->SetPosition(START_POS);
+    Par.InitAsymmetric(p);
+
+    enum { MB_CAPTURES, MB_QUIET, MB_SPECIAL, MB_DO_UNDO, MB_EVAL_COLD, MB_EVAL_HOT, MB_SWAP,
+           MB_TT_STORE, MB_TT_RETRIEVE, MB_GUIDE_BOOK, MB_MAIN_BOOK, MB_CNT };
+    sMicroStat stats[MB_CNT] = {
+        { "GenerateCaptures", 0, {} }, { "GenerateQuiet", 0, {} }, { "GenerateSpecial", 0, {} },
+        { "DoMove+UndoMove", 0, {} }, { "Evaluate, cold eval hash", 0, {} }, { "Evaluate, hot eval hash", 0, {} },
+        { "Swap", 0, {} }, { "Trans.Store", 0, {} }, { "Trans.Retrieve", 0, {} },
+        { "GuideBook probe", 0, {} }, { "MainBook probe", 0, {} },
+    };
+    sBook *books[2] = { &GuideBook, &MainBook };
+    int checksum = 0;
+
+    for (int b = 0; b < 2; b++)
+        books[b]->OpenPending();
+
+    printf("Micro-benchmark: %d positions, %d moves, %d reps\n", (int)positions.size(), (int)moves.size(), reps);
+
+    for (int rep = 0; rep <= reps; rep++) {
+        const bool keep = rep > 0;
+
+        MicroTime(&stats[MB_CAPTURES], keep, [&] {
+            for (POS &pos : positions)
+                checksum += (int)(pos.GenerateCaptures(list) - list);
+            return (U64)positions.size();
+        });
+
+        MicroTime(&stats[MB_QUIET], keep, [&] {
+            for (POS &pos : positions)
+                checksum += (int)(pos.GenerateQuiet(list) - list);
+            return (U64)positions.size();
+        });
+
+        MicroTime(&stats[MB_SPECIAL], keep, [&] {
+            for (POS &pos : positions)
+                checksum += (int)(pos.GenerateSpecial(list) - list);
+            return (U64)positions.size();
+        });
+
+        MicroTime(&stats[MB_DO_UNDO], keep, [&] {
+            for (size_t i = 0, first = 0; i < positions.size(); first = moves_end[i++])
+                for (size_t m = first; m < moves_end[i]; m++) {
+                    positions[i].DoMove(moves[m], u);
+                    checksum += (int)positions[i].mHashKey;
+                    positions[i].UndoMove(moves[m], u);
+                }
+            return (U64)moves.size();
+        });
+
+        // cold: every probe misses and stores, hot: the same positions again, mostly hits
+
+        ClearEvalHash();
+        MicroTime(&stats[MB_EVAL_COLD], keep, [&] {
+            for (POS &pos : positions)
+                checksum += Evaluate(&pos, &e);
+            return (U64)positions.size();
+        });
+
+        mEvalHashProbes = mEvalHashHits = 0;
+        MicroTime(&stats[MB_EVAL_HOT], keep, [&] {
+            for (POS &pos : positions)
+                checksum += Evaluate(&pos, &e);
+            return (U64)positions.size();
+        });
+
+        MicroTime(&stats[MB_SWAP], keep, [&] {
+            for (size_t i = 0, first = 0; i < positions.size(); first = captures_end[i++])
+                for (size_t m = first; m < captures_end[i]; m++)
+                    checksum += positions[i].Swap(Fsq(captures[m]), Tsq(captures[m]));
+            return (U64)captures.size();
+        });
+
+        Trans.Clear();
+        MicroTime(&stats[MB_TT_STORE], keep, [&] {
+            for (size_t i = 0; i < positions.size(); i++)
+                Trans.Store(positions[i].mHashKey, moves_end[i] > 0 ? moves[moves_end[i] - 1] : 0,
+                            (int)i & 255, EXACT, (int)i & 15, 0);
+            return (U64)positions.size();
+        });
+
+        MicroTime(&stats[MB_TT_RETRIEVE], keep, [&] {
+            int move, score, flag;
+            for (POS &pos : positions) {
+                move = 0;
+                checksum += Trans.Retrieve(pos.mHashKey, &move, &score, &flag, -INF, INF, 0, 0);
+                checksum += move;
+            }
+            return (U64)positions.size();
+        });
+
+        for (int b = 0; b < 2; b++) {
+            MicroTime(&stats[MB_GUIDE_BOOK + b], keep, [&] {
+                for (POS &pos : positions)
+                    checksum += books[b]->GetPolyglotMove(&pos, false);
+                return books[b]->Success() ? (U64)positions.size() : 0;
+            });
+        }
+    }
+
+    printf("%-24s %10s %9s %8s %7s %9s\n", "component", "calls", "ns/call", "sd", "cv", "min");
+    for (int i = 0; i < MB_CNT; i++)
+        PrintMicroStat(&stats[i]);
+    printf("hot eval hash %d KB: %.1f%% hits\n", mEvalHashKb,
+           mEvalHashProbes ? 100.0 * mEvalHashHits / mEvalHashProbes : 0.0);
+    for (int b = 0; b < 2; b++)
+        if (!books[b]->Success())
+            printf("book '%s' not found, set RIIIBOOKS to its directory\n", books[b]->bookName);
+
+    ClearAll();
+    printf_debug("checksum %d\n", checksum);
+}
+
+// entry point of the microbench build, used instead of UciLoop()
+
+void MicroBench(int reps) {
+
+    setbuf(stdout, NULL);
+#ifndef USE_THREADS
+    EngineSingle.MicroBench(reps);
+#else
+    Engines.front().MicroBench(reps);
+#endif
+}
+
+#endif // MICROBENCH
+
+
+// Benchmark suite:
+//
+//   bench [depth N | nodes N | movetime N] [threads N] [hash N] [pawnhash [shared] KB]
+//         [suite PATH]... [json FILE]
+//
+// PATH is either a directory holding one file per category (opening.epd, middlegame.epd,
+// endgame.epd, tactical.epd, missing ones are skipped) or a single file, which becomes
+// a category named after it. Each line holds a FEN or EPD record, optionally named with
+// an `id "..."` operation; empty lines and lines starting with '#' are skipped. Without
+// `suite` the 16 bench positions are used. Relative paths are taken from the directory
+// Rodent was started in. Default limit is depth 8, threads and hash change the options
+// for the duration of the suite, pawnhash sets the size of the per-thread pawn hash
+// tables, or of one table shared by all threads, to compare the two.
+//
+// Every position is searched as with `go`, starting from cleared hash tables and history,
+// so its numbers don't depend on the positions before it. Results are printed per position,
+// per category and in total; `json FILE` also writes them to FILE for scripts.
+
+static const char *const bench_categories[] = { "opening", "middlegame", "endgame", "tactical", NULL };
+
+struct sBenchPosition {
+    std::string fen;
+    std::string id;
+    int depth;
+    int time;
+    U64 nodes;
+    U64 tt_probes;
+    U64 tt_hits;
+    U64 pawn_probes;
+    U64 pawn_hits;
+    char best_move[6];
+};
+
+struct sBenchCategory {
+    std::string name;
+    std::vector<sBenchPosition> positions;
+    int time;
+    U64 nodes;
+    U64 tt_probes;
+    U64 tt_hits;
+    U64 pawn_probes;
+    U64 pawn_hits;
+};
+
+// FEN part of an EPD line: 4 fields, plus move counters if they are there
+
+static std::string EpdToFen(const char *line) {
+
+    std::string fen;
+    char token[256];
+
+    for (int field = 0; field < 6; field++) {
+        line = ParseToken(line, token);
+        if (*token == '\0' || (field >= 4 && !isdigit(*token))) break;
+        if (field) fen += ' ';
+        fen += token;
+    }
+    return fen;
+}
+
+static std::string EpdId(const char *line) {
+
+    const char *ptr = strstr(line, "id \"");
+    if (ptr == NULL) return "";
+    ptr += 4;
+    return std::string(ptr, strcspn(ptr, "\""));
+}
+
+static bool LoadBenchFile(const char *file_name, const char *category, std::vector<sBenchCategory> &suite) {
+
+    FILE *file = OpenFromStartDir(file_name, "r");
+    if (file == NULL) return false;
+
+    sBenchCategory cat = {};
+    char line[1024];
+
+    cat.name = category;
+    while (fgets(line, sizeof(line), file)) {
+        const char *ptr = line;
+        while (*ptr == ' ' || *ptr == '\t') ptr++;
+        if (*ptr == '#' || *ptr == '\r' || *ptr == '\n' || *ptr == '\0') continue;
+
+        sBenchPosition pos = {};
+        pos.fen = EpdToFen(ptr);
+        pos.id = EpdId(ptr);
+        cat.positions.push_back(pos);
+    }
+    fclose(file);
+
+    if (cat.positions.empty()) return false;
+    suite.push_back(cat);
+    return true;
+}
+
+static bool LoadBenchSuite(const char *path, std::vector<sBenchCategory> &suite) {
+
+    bool found = false;
+
+    for (int i = 0; bench_categories[i]; i++) {
+        std::string file_name = std::string(path) + "/" + bench_categories[i] + ".epd";
+        if (LoadBenchFile(file_name.c_str(), bench_categories[i], suite)) found = true;
+    }
+
+    if (found) return true;
+
+    // a single file, category named after it without directory and extension
+
+    std::string name = path;
+    size_t pos = name.find_last_of("/\\");
+    if (pos != std::string::npos) name.erase(0, pos + 1);
+    pos = name.rfind('.');
+    if (pos != std::string::npos && pos > 0) name.erase(pos);
+
+    return LoadBenchFile(path, name.c_str(), suite);
+}
+
+static double HitRate(U64 hits, U64 probes) {
+    return probes ? 100.0 * hits / probes : 0.0;
+}
+
+static void WriteJsonString(FILE *file, const std::string &str) {
+
+    fputc('"', file);
+    for (char c : str) {
+        if (c == '"' || c == '\\') fputc('\\', file);
+        if ((unsigned char)c >= ' ') fputc(c, file);
+    }
+    fputc('"', file);
+}
+
+static void WriteJsonTotals(FILE *file, int time, U64 nodes, U64 tt_probes, U64 tt_hits, U64 pawn_probes, U64 pawn_hits) {
+
+    fprintf(file, "\"time_ms\": %d, \"nodes\": %" PRIu64 ", \"nps\": %" PRIu64 ", \"tt_hit_rate\": %.2f, "
+            "\"pawn_probes\": %" PRIu64 ", \"pawn_hit_rate\": %.2f",
+            time, nodes, nodes * 1000 / (time + 1), HitRate(tt_hits, tt_probes), pawn_probes, HitRate(pawn_hits, pawn_probes));
+}
+
+static bool WriteBenchJson(const char *file_name, const std::vector<sBenchCategory> &suite,
+                           const char *limit, int limit_value, int total_time, U64 total_nodes,
+                           U64 tt_probes, U64 tt_hits, U64 pawn_probes, U64 pawn_hits) {
+
+    FILE *file = OpenFromStartDir(file_name, "w");
+    if (file == NULL) return false;
+
+    fprintf(file, "{\n  \"engine\": \"Rodent III\",\n");
+    fprintf(file, "  \"limit\": { \"type\": \"%s\", \"value\": %d },\n", limit, limit_value);
+    fprintf(file, "  \"threads\": %d,\n  \"hash_mb\": %d,\n", Glob.thread_no, Trans.SizeMb());
+    fprintf(file, "  \"pawn_hash\": { \"shared\": %s, \"kb\": %d },\n", SharedPawnTT.Enabled() ? "true" : "false",
+            SharedPawnTT.Enabled() ? SharedPawnTT.SizeKb() : Glob.pawn_hash_kb);
+    fprintf(file, "  \"categories\": [\n");
+
+    for (size_t c = 0; c < suite.size(); c++) {
+        const sBenchCategory &cat = suite[c];
+
+        fprintf(file, "    {\n      \"name\": ");
+        WriteJsonString(file, cat.name);
+        fprintf(file, ",\n      ");
+        WriteJsonTotals(file, cat.time, cat.nodes, cat.tt_probes, cat.tt_hits, cat.pawn_probes, cat.pawn_hits);
+        fprintf(file, ",\n      \"positions\": [\n");
+
+        for (size_t i = 0; i < cat.positions.size(); i++) {
+            const sBenchPosition &pos = cat.positions[i];
+
+            fprintf(file, "        { \"fen\": ");
+            WriteJsonString(file, pos.fen);
+            if (!pos.id.empty()) {
+                fprintf(file, ", \"id\": ");
+                WriteJsonString(file, pos.id);
+            }
+            fprintf(file, ", \"depth\": %d, \"best_move\": \"%s\", ", pos.depth, pos.best_move);
+            WriteJsonTotals(file, pos.time, pos.nodes, pos.tt_probes, pos.tt_hits, pos.pawn_probes, pos.pawn_hits);
+            fprintf(file, " }%s\n", i + 1 < cat.positions.size() ? "," : "");
+        }
+        fprintf(file, "      ]\n    }%s\n", c + 1 < suite.size() ? "," : "");
+    }
+
+    fprintf(file, "  ],\n  \"total\": { ");
+    WriteJsonTotals(file, total_time, total_nodes, tt_probes, tt_hits, pawn_probes, pawn_hits);
+    fprintf(file, " }\n}\n");
+    fclose(file);
+    return true;
+}
+
+void BenchSuite(const char *ptr) {
+
+    char token[4096], option[80];
+    std::vector<sBenchCategory> suite;
+    std::string json_file;
+    const char *limit = "depth";
+    int limit_value = 8;
+    int threads = 0, hash = 0;
+    int pawn_kb = -1;
+    bool pawn_shared = false;
+
+    for (;;) {
+        ptr = ParseToken(ptr, token);
+        if (*token == '\0')
+            break;
+        if (strcmp(token, "depth") == 0 || strcmp(token, "nodes") == 0 || strcmp(token, "movetime") == 0) {
+            limit = strcmp(token, "depth") == 0 ? "depth" : strcmp(token, "nodes") == 0 ? "nodes" : "movetime";
+            ptr = ParseToken(ptr, token);
+            limit_value = atoi(token);
+        } else if (strcmp(token, "threads") == 0) {
+            ptr = ParseToken(ptr, token);
+            threads = atoi(token);
+        } else if (strcmp(token, "hash") == 0) {
+            ptr = ParseToken(ptr, token);
+            hash = atoi(token);
+        } else if (strcmp(token, "pawnhash") == 0) {
+            ptr = ParseToken(ptr, token);
+            pawn_shared = strcmp(token, "shared") == 0;
+            if (pawn_shared) ptr = ParseToken(ptr, token);
+            pawn_kb = atoi(token);
+        } else if (strcmp(token, "suite") == 0) {
+            ptr = ParseToken(ptr, token);
+            if (!LoadBenchSuite(token, suite)) {
+                printf("info string no positions in '%s'\n", token);
+                return;
+            }
+        } else if (strcmp(token, "json") == 0) {
+            ptr = ParseToken(ptr, token);
+            json_file = token;
+        } else {
+            printf("info string unknown bench argument '%s'\n", token);
+            return;
+        }
+    }
+
+    if (limit_value <= 0) {
+        printf("info string bench %s must be positive\n", limit);
+        return;
+    }
+
+    if (suite.empty()) {
+        sBenchCategory cat = {};
+        cat.name = "bench";
+        for (int i = 0; bench_positions[i]; i++) {
+            sBenchPosition pos = {};
+            pos.fen = bench_positions[i];
+            cat.positions.push_back(pos);
+        }
+        suite.push_back(cat);
+    }
+
+    // options given to bench are restored afterwards
+
+    int old_threads = Glob.thread_no;
+    int old_hash = Trans.SizeMb();
+    int old_pawn_kb = Glob.pawn_hash_kb;
+    int old_shared_kb = SharedPawnTT.SizeKb();
+
+    if (hash) {
+        snprintf(option, sizeof(option), " name Hash value %d", hash);
+        ParseSetoption(option);
+    }
+    if (threads) {
+        snprintf(option, sizeof(option), " name Threads value %d", threads);
+        ParseSetoption(option);
+    }
+    if (pawn_kb >= 0) {
+        if (!pawn_shared) Glob.pawn_hash_kb = pawn_kb;
+        SharedPawnTT.Alloc(pawn_shared ? pawn_kb : 0); // per-thread tables follow at the first search
+    }
+
+    POS p[1];
+    int total_time = 0;
+    U64 total_nodes = 0, total_probes = 0, total_hits = 0, total_pawn_probes = 0, total_pawn_hits = 0;
+
+    printf("Benchmark suite: %s %d, %d threads, %d MB hash, pawn hash %d KB %s\n", limit, limit_value, Glob.thread_no, Trans.SizeMb(),
+           SharedPawnTT.Enabled() ? SharedPawnTT.SizeKb() : Glob.pawn_hash_kb, SharedPawnTT.Enabled() ? "shared" : "per thread");
+    Glob.is_bench = true;
+
+    for (sBenchCategory &cat : suite) {
+        for (size_t i = 0; i < cat.positions.size(); i++) {
+            sBenchPosition &pos = cat.positions[i];
+
+            Glob.ClearData(); // hash tables and history
+            p->SetPosition(pos.fen.c_str());
+
+            cEngine::msMoveTime    = *limit == 'm' ? limit_value : *limit == 'n' ? 99999999 : -1;
+            cEngine::msMoveNodes   = *limit == 'n' ? limit_value : 0;
+            cEngine::msSearchDepth = *limit == 'd' ? limit_value : 64;
+            Par.shut_up = false;
+            Glob.pondering = false;
+            Glob.nodes = 0;
+            Glob.abort_search = false;
+            Glob.depth_reached = 0;
+            Par.InitAsymmetric(p);
+
+            cEngine::msStartTime = GetMS();
+            int *pv = SearchPosition(p);
+            pos.time = GetMS() - cEngine::msStartTime;
+
+            pos.nodes = Glob.nodes;
+            pos.depth = Glob.depth_reached;
+            MoveToStr(pv[0], pos.best_move);
+#ifndef USE_THREADS
+            pos.tt_probes = EngineSingle.mTransProbes;
+            pos.tt_hits = EngineSingle.mTransHits;
+            pos.pawn_probes = EngineSingle.mPawnHashProbes;
+            pos.pawn_hits = EngineSingle.mPawnHashHits;
+#else
+            for (auto& engine: Engines) {
+                pos.tt_probes += engine.mTransProbes;
+                pos.tt_hits += engine.mTransHits;
+                pos.pawn_probes += engine.mPawnHashProbes;
+                pos.pawn_hits += engine.mPawnHashHits;
+            }
+#endif
+            cat.time += pos.time;
+            cat.nodes += pos.nodes;
+            cat.tt_probes += pos.tt_probes;
+            cat.tt_hits += pos.tt_hits;
+            cat.pawn_probes += pos.pawn_probes;
+            cat.pawn_hits += pos.pawn_hits;
+
+            printf("%-10s %3d  depth %2d  time %6d ms  nodes %10" PRIu64 "  nps %8" PRIu64 "  tt hits %5.1f%%  pawn hits %5.1f%%  best %-5s %s\n",
+                   cat.name.c_str(), (int)i + 1, pos.depth, pos.time, pos.nodes, pos.nodes * 1000 / (pos.time + 1),
+                   HitRate(pos.tt_hits, pos.tt_probes), HitRate(pos.pawn_hits, pos.pawn_probes), pos.best_move, pos.id.c_str());
+        }
+
+        printf("%-10s total  %d positions  time %d ms  nodes %" PRIu64 "  nps %" PRIu64 "  tt hits %.1f%%  pawn hits %.1f%%\n",
+               cat.name.c_str(), (int)cat.positions.size(), cat.time, cat.nodes, cat.nodes * 1000 / (cat.time + 1),
+               HitRate(cat.tt_hits, cat.tt_probes), HitRate(cat.pawn_hits, cat.pawn_probes));
+
+        total_time += cat.time;
+        total_nodes += cat.nodes;
+        total_probes += cat.tt_probes;
+        total_hits += cat.tt_hits;
+        total_pawn_probes += cat.pawn_probes;
+        total_pawn_hits += cat.pawn_hits;
+    }
+
+    Glob.is_bench = false;
+    Glob.ClearData();
+
+    printf("%" PRIu64 " nodes searched in %d, speed %" PRIu64 " nps, tt hits %.1f%%, pawn hits %.1f%%\n",
+           total_nodes, total_time, total_nodes * 1000 / (total_time + 1), HitRate(total_hits, total_probes),
+           HitRate(total_pawn_hits, total_pawn_probes));
+
+    if (!json_file.empty() && !WriteBenchJson(json_file.c_str(), suite, limit, limit_value, total_time, total_nodes,
+                                              total_probes, total_hits, total_pawn_probes, total_pawn_hits))
+        printf("info string can't write '%s'\n", json_file.c_str());
+
+    if (threads && Glob.thread_no != old_threads) {
+        snprintf(option, sizeof(option), " name Threads value %d", old_threads);
+        ParseSetoption(option);
+    }
+    if (hash && Trans.SizeMb() != old_hash) {
+        snprintf(option, sizeof(option), " name Hash value %d", old_hash);
+        ParseSetoption(option);
+    }
+    if (pawn_kb >= 0) {
+        Glob.pawn_hash_kb = old_pawn_kb;
+        SharedPawnTT.Alloc(old_shared_kb);
+    }
+}
@@ -16,329 +16,192 @@ If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include "rodent.h"
-#include "magicmoves.h"
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
 
-void cBitBoard::Init() {
-
-#ifdef USE_MAGIC
-    initmagicmoves();
+#if defined(_MSC_VER)
+    #include <intrin.h>
+    #include <immintrin.h>
 #endif
 
-    // init pawn attacks
-
-    for (int sq = 0; sq < 64; sq++) {
-        p_attacks[WC][sq] = ShiftNE(SqBb(sq)) | ShiftNW(SqBb(sq));
-        p_attacks[BC][sq] = ShiftSE(SqBb(sq)) | ShiftSW(SqBb(sq));
+const char *cCpu::Name(eCpuLevel lv) {
+
+    static const char *names[] = { "GENERIC", "POPCNT", "BMI2", "AVX2" };
+    return names[lv];
+}
+
+void cCpu::Init() {
+
+    bool popcnt = false, bmi2 = false, avx2 = false;
+    slow_pext = false;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    popcnt = __builtin_cpu_supports("popcnt");
+    bmi2 = __builtin_cpu_supports("bmi2");
+    avx2 = __builtin_cpu_supports("avx2");  // also checks that the OS saves ymm registers
+    slow_pext = __builtin_cpu_is("amdfam15h") || __builtin_cpu_is("amdfam17h");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int max_leaf = info[0];
+    bool amd = (info[1] == 0x68747541); // "Auth"enticAMD
+    __cpuid(info, 1);
+    popcnt = (info[2] >> 23) & 1;
+    int family = ((info[0] >> 8) & 0xf) + ((info[0] >> 20) & 0xff);
+    slow_pext = amd && (family == 0x15 || family == 0x17);
+    bool os_ymm = ((info[2] >> 27) & 1) && (_xgetbv(0) & 6) == 6;  // OSXSAVE and xmm/ymm state enabled
+    if (max_leaf >= 7) {
+        __cpuidex(info, 7, 0);
+        bmi2 = (info[1] >> 8) & 1;
+        avx2 = ((info[1] >> 5) & 1) && os_ymm;
     }
+#endif
 
-    // init knight attacks
-
-    for (int sq = 0; sq < 64; sq++) {
-        U64 bb_west = ShiftWest(SqBb(sq));
-        U64 bb_east = ShiftEast(SqBb(sq));
-        n_attacks[sq] = (bb_east | bb_west) << 16;
-        n_attacks[sq] |= (bb_east | bb_west) >> 16;
-        bb_west = ShiftWest(bb_west);
-        bb_east = ShiftEast(bb_east);
-        n_attacks[sq] |= (bb_east | bb_west) << 8;
-        n_attacks[sq] |= (bb_east | bb_west) >> 8;
-    }
-
-    // init king attacks
-
-    for (int sq = 0; sq < 64; sq++) {
-        k_attacks[sq] = SqBb(sq);
-        k_attacks[sq] |= ShiftSideways(k_attacks[sq]);
-        k_attacks[sq] |= (ShiftNorth(k_attacks[sq]) | ShiftSouth(k_attacks[sq]));
-    }
-
-    // init table of rays between squares
-
-    for (int sq1 = 0; sq1 < 64; sq1++) {
-        for (int sq2 = 0; sq2 < 64; sq2++) {
-            bbBetween[sq1][sq2] = GetBetween(sq1, sq2);
+    detected = CPU_GENERIC;
+    if (popcnt) {
+        detected = CPU_POPCNT;
+        if (bmi2) {
+            detected = CPU_BMI2;
+            if (avx2) detected = CPU_AVX2;
         }
     }
 
-}
-
-// from Laser, originally from chessprogramming wiki
-
-U64 cBitBoard::GetBetween(int sq1, int sq2) {
-
-    #pragma warning( suppress : 4146 )
-    const U64 m1 = C64(-1);
-    const U64 a2a7 = C64(0x0001010101010100);
-    const U64 b2g7 = C64(0x0040201008040200);
-    const U64 h1b7 = C64(0x0002040810204080); /* Thanks Dustin, g2b7 did not work for c1-a3 */
-    U64 btwn, line, rank, file;
-
-    btwn = (m1 << sq1) ^ (m1 << sq2);
-    file = (sq2 & 7) - (sq1 & 7);
-    rank = ((sq2 | 7) - sq1) >> 3;
-    line = ((file & 7) - 1) & a2a7; /* a2a7 if same file */
-    line += 2 * (((rank & 7) - 1) >> 58); /* b1g1 if same rank */
-    line += (((rank - file) & 15) - 1) & b2g7; /* b2g7 if same diagonal */
-    line += (((rank + file) & 15) - 1) & h1b7; /* h1b7 if same antidiag */
-    #pragma warning( suppress : 4146 )
-    line *= btwn & -btwn; /* mul acts like shift by smaller square */
-    return line & btwn;   /* return the bits on that line in-between */
-}
-
-#if defined(__GNUC__)
-
-#if defined(__SSSE3__) && !defined(__POPCNT__) // only for ssse3 targets
-    #include "popcnt_ssse3.h"
-    #define popcnt_gcc(x) popcnt_ssse3(x)
-#else
-    #define popcnt_gcc(x) __builtin_popcountll(x)
-#endif
+    level = detected;
+    if (const char *env = getenv("RIIICPU")) {
+        char name[16];
+        int i;
+        for (i = 0; env[i] && i < 15; i++)
+            name[i] = (char)toupper((unsigned char)env[i]);
+        name[i] = '\0';
 
-int PopCnt(U64 bb) {
-    return popcnt_gcc(bb);
-}
+        for (eCpuLevel lv = CPU_GENERIC; lv < detected; lv = eCpuLevel(lv + 1))
+            if (strcmp(name, Name(lv)) == 0) level = lv;
+    }
 
-#elif defined(USE_MM_POPCNT)
-    #include <nmmintrin.h>
-    #ifndef _M_AMD64 // 32 bit windows
-        int PopCnt(U64 bb) {
-            return _mm_popcnt_u32((unsigned int)(bb >> 32)) + _mm_popcnt_u32((unsigned int)(bb));
-        }
-    #else            // 64 bit windows
-        int PopCnt(U64 bb) {
-            return (int)_mm_popcnt_u64(bb);
-        }
-    #endif
+    use_popcnt = (level >= CPU_POPCNT);
+#ifdef USE_PEXT
+    use_pext = (level >= CPU_BMI2) && !slow_pext;
 #else
-
-int PopCnt(U64 bb) { // general purpose population count
-
-    U64 k1 = (U64)0x5555555555555555;
-    U64 k2 = (U64)0x3333333333333333;
-    U64 k3 = (U64)0x0F0F0F0F0F0F0F0F;
-    U64 k4 = (U64)0x0101010101010101;
-
-    bb -= (bb >> 1) & k1;
-    bb = (bb & k2) + ((bb >> 2) & k2);
-    bb = (bb + (bb >> 4)) & k3;
-    return (bb * k4) >> 56;
-}
-
+    use_pext = false;
 #endif
-
-int PopFirstBit(U64 *bb) {
-
-    U64 bb_local = *bb;
-    *bb &= (*bb - 1);
-    return FirstOne(bb_local);
 }
 
-U64 cBitBoard::FillNorth(U64 bb) {
-    bb |= bb << 8;
-    bb |= bb << 16;
-    bb |= bb << 32;
-    return bb;
-}
+// compile-time tables of rodent.h, C++14 still wants a definition when they are odr-used
 
-U64 cBitBoard::FillSouth(U64 bb) {
-    bb |= bb >> 8;
-    bb |= bb >> 16;
-    bb |= bb >> 32;
-    return bb;
-}
+constexpr sStepAttacks cBitBoard::msStep;
+constexpr sBetween cBitBoard::msBetween;
 
-U64 cBitBoard::FillNorthExcl(U64 bb) {
-    return FillNorth(ShiftNorth(bb));
-}
+#ifdef USE_PEXT
 
-U64 cBitBoard::FillSouthExcl(U64 bb) {
-    return FillSouth(ShiftSouth(bb));
-}
+// Slider attacks indexed by pext(occupancy, relevant mask), generated at compile time
+// with the occluded fills, independently of magicmoves. One table per square, so that
+// every constant evaluation stays small enough for default compiler limits.
 
-U64 cBitBoard::FillNorthSq(int sq) {
-    return FillNorth(SqBb(sq));
-}
+// relevant occupancy: squares on the lines of the slider, except the last one of each line
 
-U64 cBitBoard::FillSouthSq(int sq) {
-    return FillSouth(SqBb(sq));
-}
+constexpr U64 PextMask(int sq, bool bishop) {
 
-U64 cBitBoard::GetWPControl(U64 bb) {
-    return (ShiftNE(bb) | ShiftNW(bb));
+    const U64 bb_empty = ~UINT64_C(0);
+    const U64 bb_start = SqBb(sq);
+    if (bishop)
+        return (ShiftNE(FillOcclNE(bb_start, bb_empty)) | ShiftNW(FillOcclNW(bb_start, bb_empty))
+              | ShiftSE(FillOcclSE(bb_start, bb_empty)) | ShiftSW(FillOcclSW(bb_start, bb_empty)))
+              & ~(RANK_1_BB | RANK_8_BB | FILE_A_BB | FILE_H_BB);
+    return (ShiftNorth(FillOcclNorth(bb_start, bb_empty)) & ~RANK_8_BB)
+         | (ShiftSouth(FillOcclSouth(bb_start, bb_empty)) & ~RANK_1_BB)
+         | (ShiftEast(FillOcclEast(bb_start, bb_empty)) & ~FILE_H_BB)
+         | (ShiftWest(FillOcclWest(bb_start, bb_empty)) & ~FILE_A_BB);
 }
 
-U64 cBitBoard::GetBPControl(U64 bb) {
-    return (ShiftSE(bb) | ShiftSW(bb));
-}
+// inverse of pext, in software: spreads the low bits of index over the set bits of mask
 
-U64 cBitBoard::GetPawnControl(U64 bb, eColor sd) {
-    if (sd == WC) return GetWPControl(bb);
-    else          return GetBPControl(bb);
-}
+constexpr U64 Deposit(int index, U64 mask) {
 
-U64 cBitBoard::GetDoubleWPControl(U64 bb) {
-    return (ShiftNE(bb) & ShiftNW(bb));
+    U64 res = 0;
+    for (int bit = 0; mask; bit++, mask &= mask - 1)
+        if (index & (1 << bit))
+            res |= mask & (0 - mask);
+    return res;
 }
 
-U64 cBitBoard::GetDoubleBPControl(U64 bb) {
-    return (ShiftSE(bb) & ShiftSW(bb));
-}
+template<int size> struct sPextTable {
+    U64 att[size];
+};
 
-U64 cBitBoard::GetFrontSpan(U64 bb, eColor sd) {
+template<int sq, bool bishop> constexpr sPextTable<1 << PopCntGeneric(PextMask(sq, bishop))> MakePextTable() {
 
-    if (sd == WC) return BB.FillNorthExcl(bb);
-    else          return BB.FillSouthExcl(bb);
-}
+    sPextTable<1 << PopCntGeneric(PextMask(sq, bishop))> t = {};
+    const U64 mask = PextMask(sq, bishop);
+    const U64 bb_start = SqBb(sq);
 
-U64 cBitBoard::ShiftFwd(U64 bb, eColor sd) {
-
-    if (sd == WC) return ShiftNorth(bb);
-    else          return ShiftSouth(bb);
-}
-
-U64 cBitBoard::ShiftSideways(U64 bb) {
-    return (ShiftWest(bb) | ShiftEast(bb));
-}
-
-U64 cBitBoard::PawnAttacks(eColor sd, int sq) {
-    return p_attacks[sd][sq];
-}
-
-#ifndef USE_MAGIC
-
-U64 cBitBoard::FillOcclSouth(U64 bb_start, U64 bb_block) {
-
-    bb_start |= bb_block & (bb_start >> 8);
-    bb_block &= (bb_block >> 8);
-    bb_start |= bb_block & (bb_start >> 16);
-    bb_block &= (bb_block >> 16);
-    bb_start |= bb_block & (bb_start >> 32);
-    return bb_start;
-}
-
-U64 cBitBoard::FillOcclNorth(U64 bb_start, U64 bb_block) {
-
-    bb_start |= bb_block & (bb_start << 8);
-    bb_block &= (bb_block << 8);
-    bb_start |= bb_block & (bb_start << 16);
-    bb_block &= (bb_block << 16);
-    bb_start |= bb_block & (bb_start << 32);
-    return bb_start;
-}
-
-U64 cBitBoard::FillOcclEast(U64 bb_start, U64 bb_block) {
-
-    bb_block &= bbNotA;
-    bb_start |= bb_block & (bb_start << 1);
-    bb_block &= (bb_block << 1);
-    bb_start |= bb_block & (bb_start << 2);
-    bb_block &= (bb_block << 2);
-    bb_start |= bb_block & (bb_start << 4);
-    return bb_start;
-}
-
-U64 cBitBoard::FillOcclNE(U64 bb_start, U64 bb_block) {
-
-    bb_block &= bbNotA;
-    bb_start |= bb_block & (bb_start << 9);
-    bb_block &= (bb_block << 9);
-    bb_start |= bb_block & (bb_start << 18);
-    bb_block &= (bb_block << 18);
-    bb_start |= bb_block & (bb_start << 36);
-    return bb_start;
-}
-
-U64 cBitBoard::FillOcclSE(U64 bb_start, U64 bb_block) {
-
-    bb_block &= bbNotA;
-    bb_start |= bb_block & (bb_start >> 7);
-    bb_block &= (bb_block >> 7);
-    bb_start |= bb_block & (bb_start >> 14);
-    bb_block &= (bb_block >> 14);
-    bb_start |= bb_block & (bb_start >> 28);
-    return bb_start;
-}
-
-U64 cBitBoard::FillOcclWest(U64 bb_start, U64 bb_block) {
-
-    bb_block &= bbNotH;
-    bb_start |= bb_block & (bb_start >> 1);
-    bb_block &= (bb_block >> 1);
-    bb_start |= bb_block & (bb_start >> 2);
-    bb_block &= (bb_block >> 2);
-    bb_start |= bb_block & (bb_start >> 4);
-    return bb_start;
+    for (int i = 0; i < 1 << PopCntGeneric(mask); i++) {
+        U64 bb_empty = ~Deposit(i, mask);
+        if (bishop)
+            t.att[i] = ShiftNE(FillOcclNE(bb_start, bb_empty)) | ShiftNW(FillOcclNW(bb_start, bb_empty))
+                     | ShiftSE(FillOcclSE(bb_start, bb_empty)) | ShiftSW(FillOcclSW(bb_start, bb_empty));
+        else
+            t.att[i] = ShiftNorth(FillOcclNorth(bb_start, bb_empty)) | ShiftSouth(FillOcclSouth(bb_start, bb_empty))
+                     | ShiftEast(FillOcclEast(bb_start, bb_empty)) | ShiftWest(FillOcclWest(bb_start, bb_empty));
+    }
+    return t;
 }
 
-U64 cBitBoard::FillOcclSW(U64 bb_start, U64 bb_block) {
-
-    bb_block &= bbNotH;
-    bb_start |= bb_block & (bb_start >> 9);
-    bb_block &= (bb_block >> 9);
-    bb_start |= bb_block & (bb_start >> 18);
-    bb_block &= (bb_block >> 18);
-    bb_start |= bb_block & (bb_start >> 36);
-    return bb_start;
-}
+template<int sq, bool bishop> constexpr auto pext_table = MakePextTable<sq, bishop>();
 
-U64 cBitBoard::FillOcclNW(U64 bb_start, U64 bb_block) {
+#define PEXT_SQ(sq, bishop)  { PextMask(sq, bishop), pext_table<sq, bishop>.att }
+#define PEXT_RANK(r, bishop) PEXT_SQ(8 * r + 0, bishop), PEXT_SQ(8 * r + 1, bishop), PEXT_SQ(8 * r + 2, bishop), PEXT_SQ(8 * r + 3, bishop), \
+                             PEXT_SQ(8 * r + 4, bishop), PEXT_SQ(8 * r + 5, bishop), PEXT_SQ(8 * r + 6, bishop), PEXT_SQ(8 * r + 7, bishop)
 
-    bb_block &= bbNotH;
-    bb_start |= bb_block & (bb_start << 7);
-    bb_block &= (bb_block << 7);
-    bb_start |= bb_block & (bb_start << 14);
-    bb_block &= (bb_block << 14);
-    bb_start |= bb_block & (bb_start << 28);
-    return bb_start;
-}
+const sPextSlider cBitBoard::msPextR[64] = {
+    PEXT_RANK(0, false), PEXT_RANK(1, false), PEXT_RANK(2, false), PEXT_RANK(3, false),
+    PEXT_RANK(4, false), PEXT_RANK(5, false), PEXT_RANK(6, false), PEXT_RANK(7, false)
+};
 
-#endif
+const sPextSlider cBitBoard::msPextB[64] = {
+    PEXT_RANK(0, true), PEXT_RANK(1, true), PEXT_RANK(2, true), PEXT_RANK(3, true),
+    PEXT_RANK(4, true), PEXT_RANK(5, true), PEXT_RANK(6, true), PEXT_RANK(7, true)
+};
 
-U64 cBitBoard::KnightAttacks(int sq) {
-    return n_attacks[sq];
-}
+// compares pext lookups with magic lookups for every square and every subset
+// of its relevant occupancy (96256 + 5248 pairs, about 0.4 ms)
 
-U64 cBitBoard::RookAttacks(U64 bb_occ, int sq) {
+bool cBitBoard::PextMatchesMagics() {
 
-#ifdef USE_MAGIC
-    return Rmagic(sq, bb_occ);
-#else
-    U64 bb_start = SqBb(sq);
-    U64 result = ShiftNorth(FillOcclNorth(bb_start, ~bb_occ))
-                 | ShiftSouth(FillOcclSouth(bb_start, ~bb_occ))
-                 | ShiftEast(FillOcclEast(bb_start, ~bb_occ))
-                 | ShiftWest(FillOcclWest(bb_start, ~bb_occ));
-    return result;
-#endif
+    for (int sq = 0; sq < 64; sq++) {
+        if (msPextR[sq].mask != magicmoves_r_mask[sq]
+        ||  msPextB[sq].mask != magicmoves_b_mask[sq]) return false;
+
+        U64 mask = msPextR[sq].mask;
+        U64 occ = 0;
+        do {
+            if (msPextR[sq].att[Pext(occ, mask)] != Rmagic(sq, occ)) return false;
+            occ = (occ - mask) & mask; // next subset
+        } while (occ);
+
+        mask = msPextB[sq].mask;
+        do {
+            if (msPextB[sq].att[Pext(occ, mask)] != Bmagic(sq, occ)) return false;
+            occ = (occ - mask) & mask;
+        } while (occ);
+    }
+    return true;
 }
 
-U64 cBitBoard::BishAttacks(U64 bb_occ, int sq) {
-#ifdef USE_MAGIC
-    return Bmagic(sq, bb_occ);
-#else
-    U64 bb_start = SqBb(sq);
-    U64 result = ShiftNE(FillOcclNE(bb_start, ~bb_occ))
-                 | ShiftNW(FillOcclNW(bb_start, ~bb_occ))
-                 | ShiftSE(FillOcclSE(bb_start, ~bb_occ))
-                 | ShiftSW(FillOcclSW(bb_start, ~bb_occ));
-    return result;
 #endif
-}
 
-U64 cBitBoard::QueenAttacks(U64 bb_occ, int sq) {
+void cBitBoard::Init() {
 
-#ifdef USE_MAGIC
-    return Rmagic(sq, bb_occ) | Bmagic(sq, bb_occ);
-#else
-    return RookAttacks(bb_occ, sq) | BishAttacks(bb_occ, sq);
+#ifdef USE_PEXT
+    if (Cpu.use_pext && !PextMatchesMagics()) {
+        Cpu.use_pext = false;
+        printf("info string pext attack tables don't match magics, using magics\n");
+    }
 #endif
 }
 
-U64 cBitBoard::KingAttacks(int sq) {
-    return k_attacks[sq];
-}
-
 void cBitBoard::Print(U64 bb) {
 
     for (int sq = 0; sq < 64; sq++) {
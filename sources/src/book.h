@@ -34,6 +34,7 @@ struct sBook {
     int bookSizeInEntries;
     unsigned char *bookMemory;
     int bookMemoryPos;
+    bool openPending;   // bookName is opened by OpenPending(), not when it is set
     int FindPos(U64 key);
     bool IsInfrequent(int val, int max_freq);
     void ClosePolyglot();
@@ -43,14 +44,23 @@ struct sBook {
     U64 ReadInteger(int size);
   public:
     char bookName[256];
-    sBook(): bookFile(NULL), bookMemory(NULL) {}
+    sBook(): bookFile(NULL), bookMemory(NULL), openPending(false) {}
     void SetBookName(const char *name) {
 
         strcpy(bookName, name);
-        OpenPolyglot();
-        if (Glob.is_noisy)
+        ClosePolyglot();
+        openPending = true;
+        if (Glob.is_noisy) {
+            OpenPending();
             printf("info string reading book file '%s' (%s)\n", bookName,
                                         Success() ? (bookMemory ? "success/m" : "success/d") : "failure");
+        }
+    }
+    void OpenPending() {  // called at isready and ucinewgame, never during a search
+        if (openPending) {
+            openPending = false;
+            OpenPolyglot();
+        }
     }
     bool Success() const { return bookFile || bookMemory; }
     int GetPolyglotMove(POS *p, bool print_output);
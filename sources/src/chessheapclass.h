@@ -1,3 +1,4 @@
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -18,6 +19,7 @@ class ChessHeapClass {
     unsigned int tt_mask;
 
     bool success;
+    std::atomic<bool> is_clean; // memory is all zeros (fresh from calloc() or cleared), nothing stored since
 
     void Free() {           // free the allocated memory and zeroize bucket_ptrs[]
 
@@ -27,11 +29,12 @@ class ChessHeapClass {
         }
     }
 
-    void ZeroMem() {        // zeroize the allocated memory
+    void ZeroMem() {        // zeroize the allocated memory, unless it is still clean
 
-        if (success)
+        if (success && !is_clean.load(std::memory_order_relaxed))
             for (int i = 0; i < arrays_size && bucket_ptrs[i]; i++)
                 memset(bucket_ptrs[i], 0, 1024 * 1024 * bucket_sizs[i]);
+        is_clean.store(success, std::memory_order_relaxed);
     }
 
     ENTRY *MakeAddr(int entry_number) const {     // calculate address of the entry with entry_number
@@ -51,7 +54,7 @@ class ChessHeapClass {
         success = true;
         for (int i = 0; size_mb > 0 && success; i++) {
             bucket_sizs[i] = size_mb > bucket_size_mb ? bucket_size_mb : size_mb;
-            bucket_ptrs[i] = (ENTRY *) malloc(1024 * 1024 * bucket_sizs[i]);
+            bucket_ptrs[i] = (ENTRY *) calloc(1024 * 1024, bucket_sizs[i]); // zero pages are mapped on first use
             success = bucket_ptrs[i] != NULL;
             size_mb -= bucket_size_mb;
 
@@ -62,6 +65,7 @@ class ChessHeapClass {
         if (!success)
             Free();
 
+        is_clean.store(success, std::memory_order_relaxed);
         return success;
     }
 
@@ -69,7 +73,7 @@ class ChessHeapClass {
 
     int tt_date;
 
-    ChessHeapClass(): bucket_ptrs{}, success{false} {};
+    ChessHeapClass(): bucket_ptrs{}, success{false}, is_clean{false} {};
 
     ~ChessHeapClass() {
 
@@ -77,8 +81,15 @@ class ChessHeapClass {
     }
 
     void AllocTrans(unsigned int mbsize);
+    int SizeMb() const { return success ? tt_size / (1024 * 1024 / sizeof(ENTRY)) : 0; }
     void Clear();
     bool Retrieve(U64 key, int *move, int *score, int *flag, int alpha, int beta, int depth, int ply);
+    bool Probe(U64 key, sTransProbe *probe, int ply);
     void RetrieveMove(U64 key, int *move);
     void Store(U64 key, int move, int score, int flags, int depth, int ply);
+
+    void PrefetchBucket(U64 key) const {    // start loading the bucket of key into cache
+
+        if (success) Prefetch(MakeAddr(key & tt_mask));
+    }
 };
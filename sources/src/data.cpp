@@ -22,9 +22,9 @@ int POS::msCastleMask[64];
 const int tp_value[7] = { 100, 325, 325, 500, 1000,  0,   0 };
 const int ph_value[7] = {   0,   1,   1,   2,    4,  0,   0 };
 
-U64 POS::msZobPiece[12][64];
-U64 POS::msZobCastle[16];
-U64 POS::msZobEp[8];
+#include "zobrist.h"
+U64 POS::msCuckooKey[CUCKOO_SIZE];
+int POS::msCuckooMove[CUCKOO_SIZE];
 int tDepth[MAX_THREADS];
 int cEngine::msMoveTime;
 int cEngine::msMoveNodes;
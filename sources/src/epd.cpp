@@ -80,6 +80,7 @@ double cEngine::TexelFit(POS *p, int *pv) {
   int iter = 0;
   int div = 2000000;
   Trans.Clear();
+  AllocMaterialHash();
   ClearAll();
 
   double result = 1;
@@ -20,20 +20,139 @@ If not, see <http://www.gnu.org/licenses/>.
 #include <cstdio>
 #include <cstring>
 #include <cmath> // round
+#include <new>
+
+// time the rest of the enclosing scope as a part of eval, compiled only with USE_EVAL_PROFILE
+
+#ifdef USE_EVAL_PROFILE
+    #define EVAL_PROFILE(part) cEvalTimer eval_timer(&mEvalProfile, part)
+    #define EVAL_PROFILE_COUNT(counter) (mEvalProfile.counter++)
+#else
+    #define EVAL_PROFILE(part) ((void)0)
+    #define EVAL_PROFILE_COUNT(counter) ((void)0)
+#endif
 
 void cEngine::ClearAll() {
 
     ClearPawnHash();
     ClearEvalHash();
+    ClearMaterialHash();
     ClearHist();
+    mEvalHashProbes = mEvalHashHits = 0;
+    mPawnHashProbes = mPawnHashHits = 0;
+    mTransProbes = mTransHits = 0;
+#ifdef USE_LAZY_EVAL_STATS
+    mLazyExits = mLazyErrors = 0;
+#endif
 }
 
 void cEngine::ClearEvalHash() {
 
-    ZEROARRAY(mEvalTT);
+    if (mEvalTT)
+        memset(mEvalTT.get(), 0, (mEvalHashMask + 1) * sizeof(sEvalHashEntry));
+}
+
+// (Re)allocate eval hash if EvalHashKB has changed. Called by the worker
+// before searching, so engines that never search don't use any memory.
+// Size is rounded down to a power of 2 entries, 0 KB means no eval hash.
+
+void cEngine::AllocEvalHash() {
+
+    if (mEvalHashKb == Glob.eval_hash_kb) return;
+
+    mEvalHashKb = Glob.eval_hash_kb;
+    mEvalTT.reset();
+    mEvalHashMask = 0;
+
+    if (mEvalHashKb <= 0) return;
+
+    U64 entries = 1;
+    while (entries * 2 * sizeof(sEvalHashEntry) <= (U64)mEvalHashKb * 1024)
+        entries *= 2;
+
+    mEvalTT.reset(new (std::nothrow) sEvalHashEntry[entries]());
+
+    if (!mEvalTT) {
+        if (Glob.is_noisy)
+            printf("info string eval hash allocation error\n");
+        return;
+    }
+
+    mEvalHashMask = entries - 1;
 }
 
-void cEngine::EvaluateMaterial(POS *p, eData *e, eColor sd) {
+// Allocate material hash unless it's already there. Unlike eval and pawn hash it
+// can't be switched off, as Evaluate() reads material scores from it.
+
+void cEngine::AllocMaterialHash() {
+
+    if (mMatTT) return;
+
+    mMatTT.reset(new sMaterialEntry[MAT_HASH_SIZE]);
+    ClearMaterialHash();
+}
+
+void cEngine::ClearMaterialHash() {
+
+    // key 0 belongs to the position with bare kings, so empty slots get ~0 instead
+
+    for (int i = 0; mMatTT && i < MAT_HASH_SIZE; i++)
+        mMatTT[i].key = ~0ULL;
+}
+
+// Returns material hash entry for the current piece counts, filling it on a miss.
+// The key is exact (see MatKey()), so there are no false hits to worry about.
+
+const sMaterialEntry *cEngine::ProbeMaterial(POS *p) {
+
+    sMaterialEntry *me = &mMatTT[(p->mMaterialKey * 0x9E3779B97F4A7C15ULL) >> (64 - MAT_HASH_BITS)];
+
+    if (me->key == p->mMaterialKey)
+        return me;
+
+    me->key = p->mMaterialKey;
+
+    // Piece values, interpolated here once for all positions with this material
+
+    int mg_val = 0, eg_val = 0;
+    for (int pc = P; pc < K; pc++) {
+        mg_val += (p->mCnt[WC][pc] - p->mCnt[BC][pc]) * Par.mat_mg[pc];
+        eg_val += (p->mCnt[WC][pc] - p->mCnt[BC][pc]) * Par.mat_eg[pc];
+    }
+    int mg_phase = Min(p->mPhase, 24);
+    me->piece_value = (mg_val * mg_phase + eg_val * (24 - mg_phase)) / 24;
+
+    for (eColor sd = WC; sd < 2; ++sd) {
+        me->material[sd] = EvaluateMaterial(p, sd);
+        me->keep[sd] = Par.keep_pc[Q] * p->mCnt[sd][Q]
+                     + Par.keep_pc[R] * p->mCnt[sd][R]
+                     + Par.keep_pc[B] * p->mCnt[sd][B]
+                     + Par.keep_pc[N] * p->mCnt[sd][N]
+                     + Par.keep_pc[P] * p->mCnt[sd][P];
+        SetDrawFactor(p, sd, me);
+    }
+
+    // Material imbalance evaluation (based on Crafty)
+
+    int minor_balance = p->mCnt[WC][N] - p->mCnt[BC][N] + p->mCnt[WC][B] - p->mCnt[BC][B];
+    int major_balance = p->mCnt[WC][R] - p->mCnt[BC][R] + 2 * p->mCnt[WC][Q] - 2 * p->mCnt[BC][Q];
+
+    int x = Max(major_balance + 4, 0);
+    if (x > 8) x = 8;
+
+    int y = Max(minor_balance + 4, 0);
+    if (y > 8) y = 8;
+
+    me->imbalance = Par.imbalance[x][y];
+
+    // Special case code for mating the lone king and KBN vs K
+
+    me->endgame = NeedsCheckmateHelper(p) ? CheckmateHelper : NULL;
+
+    return me;
+}
+
+int cEngine::EvaluateMaterial(POS *p, eColor sd) {
 
     eColor op = ~sd;
 
@@ -49,16 +168,16 @@ void cEngine::EvaluateMaterial(POS *p, eData *e, eColor sd) {
     if (p->mCnt[sd][Q])
         tmp -= V(ELEPH) * (p->mCnt[op][N] + p->mCnt[op][B]);
 
-    Add(e, sd, tmp);
+    return tmp;
 }
 
-void cEngine::EvaluatePieces(POS *p, eData *e, eColor sd) {
+template<eColor sd>
+void cEngine::EvaluatePieces(POS *p, eData *e) {
 
     U64 bb_pieces, bb_attack, bb_control, bb_possible, bb_contact, bb_zone, bb_file;
     int sq, cnt, own_p_cnt, opp_p_cnt;
     int r_on_7th = 0;
-    int mob_mg = 0;
-    int mob_eg = 0;
+    tScore mob = 0;
     int tropism_mg = 0;
     int tropism_eg = 0;
     int lines_mg = 0;
@@ -67,14 +186,28 @@ void cEngine::EvaluatePieces(POS *p, eData *e, eColor sd) {
     int fwd_cnt = 0;
     int outpost_mg = 0;
 	int outpost_eg = 0;
-    int center_control = 2 * PopCnt(e->p_takes[sd] & Mask.center);
+    int center_control = 0;
+
+    // Terms with zero weight are not computed (see cParam::InitSkippedTerms())
+
+    const int skip = Par.skip_terms[sd];
+    const bool do_mob = !(skip & ET_MOBILITY);
+    const bool do_att = !(skip & ET_KING_ATT);
+    const bool do_tropism = !(skip & ET_TROPISM);
+    const bool do_lines = !(skip & ET_LINES);
+    const bool do_fwd = !(skip & ET_FWD);
+    const bool do_outposts = !(skip & ET_OUTPOSTS);
+    const bool do_center = !(skip & ET_CENTER);
+
+    if (do_center)
+        center_control = 2 * PopCnt(e->p_takes[sd] & Mask.center);
 
     // Init king attack zone
 
-    eColor op = ~sd;
+    constexpr eColor op = ~sd;
     int king_sq = p->KingSq(op);
     bb_zone = BB.KingAttacks(king_sq);
-    bb_zone |= BB.ShiftFwd(bb_zone, op);
+    bb_zone |= ShiftFwd<op>(bb_zone);
 
 	// Factor in minor pieces as king defenders
 
@@ -99,21 +232,23 @@ void cEngine::EvaluatePieces(POS *p, eData *e, eColor sd) {
 
         // knight tropism to enemy king (based on Gambit Fruit)
 
-        tropism_mg += V(NTR_MG) * Dist.bonus[sq][king_sq];
-        tropism_eg += V(NTR_EG) * Dist.bonus[sq][king_sq];
+        if (do_tropism) {
+            tropism_mg += V(NTR_MG) * Dist.bonus[sq][king_sq];
+            tropism_eg += V(NTR_EG) * Dist.bonus[sq][king_sq];
+        }
 
-        if (SqBb(sq) & Mask.away[sd]) {                          // forwardness (based on Toga II 3.0)
+        if (do_fwd && (SqBb(sq) & Mask.away[sd])) {                          // forwardness (based on Toga II 3.0)
             fwd_weight += V(N_FWD);
             fwd_cnt += 1;
         }
 
         bb_control = BB.KnightAttacks(sq) & ~p->mClBb[sd];       // get control bitboard
-        center_control += PopCnt(bb_control & Mask.center);
+        if (do_center) center_control += PopCnt(bb_control & Mask.center);
         if (!(bb_control  & ~e->p_takes[op] & Mask.away[sd]))    // we do not attack enemy half of the board
             Add(e, sd, V(N_OWH_MG), V(N_OWH_EG) );
         e->all_att[sd] |= BB.KnightAttacks(sq);
         e->ev_att[sd]  |= bb_control;
-        if (bb_control & n_checks) e->att[sd] += V(N_CHK);// check threats
+        if (do_att && (bb_control & n_checks)) e->att[sd] += V(N_CHK);// check threats
 
         bb_possible = bb_control & ~e->p_takes[op];              // reachable outposts
         bb_possible &= ~e->p_can_take[op];
@@ -121,18 +256,21 @@ void cEngine::EvaluatePieces(POS *p, eData *e, eColor sd) {
         if (bb_possible) Add(e, sd, V(N_REACH_MG), V(N_REACH_EG));
 
         bb_attack = BB.KnightAttacks(sd);
-        if (bb_attack & bb_zone) {                               // king attack
+        if (do_att && (bb_attack & bb_zone)) {                   // king attack
             e->wood[sd]++;
             e->att[sd] += V(N_ATT1) * PopCnt(bb_attack & (bb_zone & ~e->p_takes[op]));
             e->att[sd] += V(N_ATT2) * PopCnt(bb_attack & (bb_zone & e->p_takes[op]));
         }
 
-        cnt = PopCnt(bb_control & ~e->p_takes[op]);           // get mobility count
-        mob_mg += Par.n_mob_mg[cnt];
-        mob_eg += Par.n_mob_eg[cnt];
+        if (do_mob) {
+            cnt = PopCnt(bb_control & ~e->p_takes[op]);       // get mobility count
+            mob += Par.n_mob[cnt];
+        }
 
-		EvaluateShielded(p, e, sd, sq, V(N_SH_MG), V(N_SH_EG), &outpost_mg, &outpost_eg);   // knight shielded by a pawn
-        EvaluateOutpost(p, e, sd, N, sq, &outpost_mg, &outpost_eg);    // outpost
+        if (do_outposts) {
+            EvaluateShielded(p, e, sd, sq, V(N_SH_MG), V(N_SH_EG), &outpost_mg, &outpost_eg);   // knight shielded by a pawn
+            EvaluateOutpost(p, e, sd, N, sq, &outpost_mg, &outpost_eg);    // outpost
+        }
     }
 
     // Bishop eval
@@ -143,43 +281,50 @@ void cEngine::EvaluatePieces(POS *p, eData *e, eColor sd) {
 
         // bishop tropism  to enemy king (based on Gambit Fruit)
 
-        tropism_mg += V(BTR_MG) * Dist.bonus[sq][king_sq];
-        tropism_eg += V(BTR_EG) * Dist.bonus[sq][king_sq];
+        if (do_tropism) {
+            tropism_mg += V(BTR_MG) * Dist.bonus[sq][king_sq];
+            tropism_eg += V(BTR_EG) * Dist.bonus[sq][king_sq];
+        }
 
-        if (SqBb(sq) & Mask.away[sd]) {                          // forwardness (based on Toga II 3.0)
+        if (do_fwd && (SqBb(sq) & Mask.away[sd])) {                          // forwardness (based on Toga II 3.0)
             fwd_weight += V(B_FWD);
             fwd_cnt += 1;
         }
 
         bb_control = BB.BishAttacks(p->OccBb(), sq);             // get control bitboard
-        center_control += PopCnt(bb_control & Mask.center);
+        if (do_center) center_control += PopCnt(bb_control & Mask.center);
         e->all_att[sd] |= bb_control;                            // update attack map
         e->ev_att[sd]  |= bb_control;
         if (!(bb_control & Mask.away[sd]))
              Add(e, sd, V(B_OWH_MG), V(B_OWH_EG) ); // we do not attack enemy half of the board
-		if (bb_control & b_checks) {
-			e->att[sd] += V(B_CHK);  // check threats
-		}
+        if (do_att) {
+            if (bb_control & b_checks) {
+                e->att[sd] += V(B_CHK);  // check threats
+            }
 
-        bb_attack = BB.BishAttacks(p->OccBb() ^ p->Queens(sd), sq);  // get king attack bitboard
+            bb_attack = BB.BishAttacks(p->OccBb() ^ p->Queens(sd), sq);  // get king attack bitboard
 
-        if (bb_attack & bb_zone) {                               // evaluate king attacks
-            e->wood[sd]++;
-            e->att[sd] += V(B_ATT1) * PopCnt(bb_attack & (bb_zone & ~e->p_takes[op]));
-            e->att[sd] += V(B_ATT2) * PopCnt(bb_attack & (bb_zone & e->p_takes[op]));
+            if (bb_attack & bb_zone) {                           // evaluate king attacks
+                e->wood[sd]++;
+                e->att[sd] += V(B_ATT1) * PopCnt(bb_attack & (bb_zone & ~e->p_takes[op]));
+                e->att[sd] += V(B_ATT2) * PopCnt(bb_attack & (bb_zone & e->p_takes[op]));
+            }
         }
 
-        cnt = PopCnt(bb_control & ~e->p_takes[op] & ~bb_excluded); // get mobility count
-        mob_mg += Par.b_mob_mg[cnt];
-        mob_eg += Par.b_mob_eg[cnt];
+        if (do_mob) {
+            cnt = PopCnt(bb_control & ~e->p_takes[op] & ~bb_excluded); // get mobility count
+            mob += Par.b_mob[cnt];
+        }
 
         bb_possible = bb_control & ~e->p_takes[op];              // reachable outposts
         bb_possible &= ~e->p_can_take[op];
         bb_possible &= Mask.outpost_map[sd];
         if (bb_possible) Add(e, sd, V(B_REACH_MG), V(B_REACH_EG));
 
-		EvaluateShielded(p, e, sd, sq, V(B_SH_MG), V(B_SH_EG), &outpost_mg, &outpost_eg);  // bishop shielded by a pawn
-        EvaluateOutpost(p, e, sd, B, sq, &outpost_mg, &outpost_eg);              // outpost
+        if (do_outposts) {
+            EvaluateShielded(p, e, sd, sq, V(B_SH_MG), V(B_SH_EG), &outpost_mg, &outpost_eg);  // bishop shielded by a pawn
+            EvaluateOutpost(p, e, sd, B, sq, &outpost_mg, &outpost_eg);              // outpost
+        }
 
         // Bishops side by side
 
@@ -210,10 +355,12 @@ void cEngine::EvaluatePieces(POS *p, eData *e, eColor sd) {
 
         // rook tropism to enemy king (based on Gambit Fruit)
 
-        tropism_mg += V(RTR_MG) * Dist.bonus[sq][king_sq];
-        tropism_eg += V(RTR_EG) * Dist.bonus[sq][king_sq];
+        if (do_tropism) {
+            tropism_mg += V(RTR_MG) * Dist.bonus[sq][king_sq];
+            tropism_eg += V(RTR_EG) * Dist.bonus[sq][king_sq];
+        }
 
-        if (SqBb(sq) & Mask.away[sd]) {                          // forwardness (based on Toga II 3.0)
+        if (do_fwd && (SqBb(sq) & Mask.away[sd])) {                          // forwardness (based on Toga II 3.0)
             fwd_weight += V(R_FWD);
             fwd_cnt += 1;
         }
@@ -222,31 +369,36 @@ void cEngine::EvaluatePieces(POS *p, eData *e, eColor sd) {
         e->all_att[sd] |= bb_control;                            // update attack map
         e->ev_att[sd] |= bb_control;
 
-        if ((bb_control & ~p->mClBb[sd] & r_checks)
-        && p->Queens(sd)) {
-            e->att[sd] += V(R_CHK);                              // check threat bonus
-            bb_contact = (bb_control & BB.KingAttacks(king_sq)) & r_checks;  // get contact check bitboard
-
-            while (bb_contact) {
-                int contactSq = PopFirstBit(&bb_contact);     // find a potential contact check
-                if (p->Swap(sq, contactSq) >= 0) {               // rook exchanges are also accepted
-                    e->att[sd] += V(R_CONTACT);
-                    break;
+        if (do_att) {
+            if ((bb_control & ~p->mClBb[sd] & r_checks)
+            && p->Queens(sd)) {
+                e->att[sd] += V(R_CHK);                          // check threat bonus
+                bb_contact = (bb_control & BB.KingAttacks(king_sq)) & r_checks;  // get contact check bitboard
+
+                while (bb_contact) {
+                    int contactSq = PopFirstBit(&bb_contact);    // find a potential contact check
+                    if (p->Swap(sq, contactSq) >= 0) {           // rook exchanges are also accepted
+                        e->att[sd] += V(R_CONTACT);
+                        break;
+                    }
                 }
             }
-        }
 
-        bb_attack = BB.RookAttacks(p->OccBb() ^ p->StraightMovers(sd), sq);// get king attack bitboard
+            bb_attack = BB.RookAttacks(p->OccBb() ^ p->StraightMovers(sd), sq);// get king attack bitboard
 
-        if (bb_attack & bb_zone) {                                         // evaluate king attacks
-            e->wood[sd]++;
-            e->att[sd] += V(R_ATT1) * PopCnt(bb_attack & (bb_zone & ~e->p_takes[op]));
-            e->att[sd] += V(R_ATT2) * PopCnt(bb_attack & (bb_zone & e->p_takes[op]));
+            if (bb_attack & bb_zone) {                                     // evaluate king attacks
+                e->wood[sd]++;
+                e->att[sd] += V(R_ATT1) * PopCnt(bb_attack & (bb_zone & ~e->p_takes[op]));
+                e->att[sd] += V(R_ATT2) * PopCnt(bb_attack & (bb_zone & e->p_takes[op]));
+            }
         }
 
-        cnt = PopCnt(bb_control & ~bb_excluded);                        // get mobility count
-        mob_mg += Par.r_mob_mg[cnt];
-        mob_eg += Par.r_mob_eg[cnt];
+        if (do_mob) {
+            cnt = PopCnt(bb_control & ~bb_excluded);                    // get mobility count
+            mob += Par.r_mob[cnt];
+        }
+
+        if (!do_lines) continue;
 
         // FILE EVALUATION:
 
@@ -257,8 +409,8 @@ void cEngine::EvaluatePieces(POS *p, eData *e, eColor sd) {
             lines_eg += V(ROQ_EG);
         }
 
-        if (!(bb_file & p->Pawns(sd))) {                         // no own pawns on that file
-            if (!(bb_file & p->Pawns(op))) {                     // open file
+        if (SqBb(sq) & e->half_open[sd]) {                       // no own pawns on that file
+            if (SqBb(sq) & e->half_open[op]) {                   // open file
                 lines_mg += V(ROF_MG);
                 lines_eg += V(ROF_EG);
             } else {                                             // half-open file...
@@ -292,43 +444,49 @@ void cEngine::EvaluatePieces(POS *p, eData *e, eColor sd) {
 
         // queen tropism to enemy king (based on Gambit Fruit)
 
-        tropism_mg += V(QTR_MG) * Dist.bonus[sq][king_sq];
-        tropism_eg += V(QTR_EG) * Dist.bonus[sq][king_sq];
+        if (do_tropism) {
+            tropism_mg += V(QTR_MG) * Dist.bonus[sq][king_sq];
+            tropism_eg += V(QTR_EG) * Dist.bonus[sq][king_sq];
+        }
 
-        if (SqBb(sq) & Mask.away[sd]) {                          // forwardness (based on Toga II 3.0)
+        if (do_fwd && (SqBb(sq) & Mask.away[sd])) {                          // forwardness (based on Toga II 3.0)
             fwd_weight += V(Q_FWD);
             fwd_cnt += 1;
         }
 
         bb_control = BB.QueenAttacks(p->OccBb(), sq);            // get control bitboard
         e->all_att[sd] |= bb_control;                            // update attack map
-        if (bb_control & q_checks) {                             // check threat bonus
-            e->att[sd] += V(Q_CHK);
-
-            bb_contact = bb_control & BB.KingAttacks(king_sq);   // queen contact checks
-            while (bb_contact) {
-                int contactSq = PopFirstBit(&bb_contact);     // find potential contact check square
-                if (p->Swap(sq, contactSq) >= 0) {               // if check doesn't lose material, evaluate
-                    e->att[sd] += V(Q_CONTACT);
-                    break;
+
+        if (do_att) {
+            if (bb_control & q_checks) {                         // check threat bonus
+                e->att[sd] += V(Q_CHK);
+
+                bb_contact = bb_control & BB.KingAttacks(king_sq); // queen contact checks
+                while (bb_contact) {
+                    int contactSq = PopFirstBit(&bb_contact);    // find potential contact check square
+                    if (p->Swap(sq, contactSq) >= 0) {           // if check doesn't lose material, evaluate
+                        e->att[sd] += V(Q_CONTACT);
+                        break;
+                    }
                 }
             }
-        }
 
-        bb_attack  = BB.BishAttacks(p->OccBb() ^ p->DiagMovers(sd), sq);
-        bb_attack |= BB.RookAttacks(p->OccBb() ^ p->StraightMovers(sd), sq);
+            bb_attack  = BB.BishAttacks(p->OccBb() ^ p->DiagMovers(sd), sq);
+            bb_attack |= BB.RookAttacks(p->OccBb() ^ p->StraightMovers(sd), sq);
 
-        if (bb_attack & bb_zone) {                               // evaluate king attacks
-            e->wood[sd]++;
-            e->att[sd] += V(Q_ATT1) * PopCnt(bb_attack & (bb_zone & ~e->p_takes[op]));
-            e->att[sd] += V(Q_ATT2) * PopCnt(bb_attack & (bb_zone & e->p_takes[op]));
+            if (bb_attack & bb_zone) {                           // evaluate king attacks
+                e->wood[sd]++;
+                e->att[sd] += V(Q_ATT1) * PopCnt(bb_attack & (bb_zone & ~e->p_takes[op]));
+                e->att[sd] += V(Q_ATT2) * PopCnt(bb_attack & (bb_zone & e->p_takes[op]));
+            }
         }
 
-        cnt = PopCnt(bb_control & ~bb_excluded);              // get mobility count
-        mob_mg += Par.q_mob_mg[cnt];
-        mob_eg += Par.q_mob_eg[cnt];
+        if (do_mob) {
+            cnt = PopCnt(bb_control & ~bb_excluded);             // get mobility count
+            mob += Par.q_mob[cnt];
+        }
 
-        if (SqBb(sq) & bb_rel_rank[sd][RANK_7]) {                // queen on 7th rank
+        if (do_lines && (SqBb(sq) & bb_rel_rank[sd][RANK_7])) {  // queen on 7th rank
             if (p->Pawns(op) & bb_rel_rank[sd][RANK_7]           // attacking enemy pawns
             ||  p->Kings(op) & bb_rel_rank[sd][RANK_8]) {        // or cutting off enemy king
                 lines_mg += V(QSR_MG);
@@ -342,12 +500,12 @@ void cEngine::EvaluatePieces(POS *p, eData *e, eColor sd) {
 
 		if (b & ~(bb_rel_rank[sd][RANK_1] | bb_rel_rank[sd][RANK_2]) ) {
 			int tmp = 0;
-			if (p->IsOnSq(sd, N, REL_SQ(sd, B1))) tmp -= 2;
-			if (p->IsOnSq(sd, N, REL_SQ(sd, G1))) tmp -= 2;
-			if (p->IsOnSq(sd, B, REL_SQ(sd, C1))) tmp -= 2;
-			if (p->IsOnSq(sd, B, REL_SQ(sd, F1))) tmp -= 2;
-			if (p->IsOnSq(sd, P, REL_SQ(sd, E2))) tmp -= 3;
-			if (p->IsOnSq(sd, P, REL_SQ(sd, D2))) tmp -= 3;
+			if (p->IsOnSq(sd, N, REL_SQ(B1, sd))) tmp -= 2;
+			if (p->IsOnSq(sd, N, REL_SQ(G1, sd))) tmp -= 2;
+			if (p->IsOnSq(sd, B, REL_SQ(C1, sd))) tmp -= 2;
+			if (p->IsOnSq(sd, B, REL_SQ(F1, sd))) tmp -= 2;
+			if (p->IsOnSq(sd, P, REL_SQ(E2, sd))) tmp -= 3;
+			if (p->IsOnSq(sd, P, REL_SQ(D2, sd))) tmp -= 3;
 			Add(e, sd, tmp, 0);
 		}
 
@@ -362,7 +520,7 @@ void cEngine::EvaluatePieces(POS *p, eData *e, eColor sd) {
 
     // Weighting eval parameters
 
-    Add(e, sd, (Par.sd_mob[sd] * mob_mg)  / 100, (Par.sd_mob[sd] * mob_eg)  / 100);
+    Add(e, sd, (Par.sd_mob[sd] * MgScore(mob)) / 100, (Par.sd_mob[sd] * EgScore(mob)) / 100);
     Add(e, sd, (V(W_TROPISM) * tropism_mg) / 100, (V(W_TROPISM) * tropism_eg) / 100);
     Add(e, sd, (V(W_LINES) * lines_mg)     / 100, (V(W_LINES) * lines_eg)     / 100);
     Add(e, sd, (V(W_FWD) * fwd_bonus[fwd_cnt] * fwd_weight) / 100, 0);
@@ -409,11 +567,12 @@ void cEngine::EvaluateOutpost(POS *p, eData *e, eColor sd, int pc, int sq, int *
     }
 }
 
-void cEngine::EvaluatePawns(POS *p, eData *e, eColor sd) {
+template<eColor sd>
+void cEngine::EvaluatePawns(POS *p, eData *e) {
 
     U64 bb_pieces, front_span, fl_phalanx, fl_defended;
     int sq, fl_unopposed;
-    eColor op = ~sd;
+    constexpr eColor op = ~sd;
     int mass_mg = 0;
     int mass_eg = 0;
 
@@ -423,7 +582,7 @@ void cEngine::EvaluatePawns(POS *p, eData *e, eColor sd) {
         // Set data and flags
 
         sq = PopFirstBit(&bb_pieces);
-        front_span = BB.GetFrontSpan(SqBb(sq), sd);
+        front_span = FrontSpan<sd>(SqBb(sq));
         fl_unopposed = ((front_span & p->Pawns(op)) == 0);
         fl_phalanx = (BB.ShiftSideways(SqBb(sq)) & p->Pawns(sd));
         fl_defended = (SqBb(sq) & e->p_takes[sd]);
@@ -464,56 +623,62 @@ void cEngine::EvaluatePawns(POS *p, eData *e, eColor sd) {
     AddPawns(e, sd, (mass_mg * V(W_MASS)) / 100, (mass_eg * V(W_MASS)) / 100);
 }
 
-void cEngine::EvaluatePassers(POS *p, eData *e, eColor sd) {
+// EvaluatePawns() is called from EvaluatePawnStruct() in eval_pawn.cpp
+
+template void cEngine::EvaluatePawns<WC>(POS *p, eData *e);
+template void cEngine::EvaluatePawns<BC>(POS *p, eData *e);
+
+template<eColor sd>
+void cEngine::EvaluatePassers(POS *p, eData *e) {
 
     U64 bb_pieces, bb_pawn, bb_stop;
     int sq, mg_tmp, eg_tmp, mul;
-    eColor op = ~sd;
+    constexpr eColor op = ~sd;
     int mg_tot = 0;
     int eg_tot = 0;
 
-    bb_pieces = p->Pawns(sd);
-    while (bb_pieces) {
-        sq = PopFirstBit(&bb_pieces);
-        bb_pawn = SqBb(sq);
-        bb_stop = BB.ShiftFwd(SqBb(sq), sd);
+    // pawn mobility (pawns with empty stop square)
 
-        // pawn mobility
+    bb_pieces = p->Pawns(sd) & ShiftFwd<op>(p->UnoccBb());
+    int cnt = PopCnt(bb_pieces);
+    Add(e, sd, cnt * V(P_MOB_MG), cnt * V(P_MOB_EG));    // pawn mobility bonus
+    Add(e, sd, 2 * PopCnt(bb_pieces & Mask.center), 0); // additional central pawn mobility bonus
 
-        if (!(bb_stop & p->OccBb())) {
-			Add(e, sd, V(P_MOB_MG), V(P_MOB_EG));        // pawn mobility bonus
-			if (bb_pawn & Mask.center) Add(e, sd, 2, 0); // additional central pawn mobility bonus
+    // TODO: pawn can attack enemy piece in one move
 
-			// TODO: pawn can attack enemy piece in one move
-        }
+    // passed pawns (found by EvaluatePawnStruct())
 
-        // passed pawns
+    if (Par.skip_terms[sd] & ET_PASSERS) return;
 
-        if (!(Mask.passed[sd][sq] & p->Pawns(op))) {
-            mul = 100;
+    bb_pieces = e->passers[sd];
+    while (bb_pieces) {
+        sq = PopFirstBit(&bb_pieces);
+        bb_pawn = SqBb(sq);
+        bb_stop = ShiftFwd<sd>(SqBb(sq));
 
-            if (bb_pawn & e->p_takes[sd]) mul += V(P_DEFMUL);
-            if (bb_stop & e->p_takes[sd]) mul += V(P_STOPMUL);
+        mul = 100;
 
-            if (bb_stop & p->OccBb()) mul -= V(P_BL_MUL);   // blocked passers score less
+        if (bb_pawn & e->p_takes[sd]) mul += V(P_DEFMUL);
+        if (bb_stop & e->p_takes[sd]) mul += V(P_STOPMUL);
 
-            else if ((bb_stop & e->all_att[sd])  // our control of stop square
-                 && (bb_stop & ~e->all_att[op])) mul += V(P_OURSTOP_MUL);
+        if (bb_stop & p->OccBb()) mul -= V(P_BL_MUL);   // blocked passers score less
 
-            else if ((bb_stop & e->all_att[op])  // opp control of stop square
-                 && (bb_stop & ~e->all_att[sd])) mul -= V(P_OPPSTOP_MUL);
+        else if ((bb_stop & e->all_att[sd])  // our control of stop square
+             && (bb_stop & ~e->all_att[op])) mul += V(P_OURSTOP_MUL);
 
-            // in the midgame, we use just a bonus from the table
-            // in the endgame, passed pawn attracts both kings.
+        else if ((bb_stop & e->all_att[op])  // opp control of stop square
+             && (bb_stop & ~e->all_att[sd])) mul -= V(P_OPPSTOP_MUL);
 
-            mg_tmp = Par.passed_bonus_mg[sd][Rank(sq)];
-            eg_tmp = Par.passed_bonus_eg[sd][Rank(sq)]
-                     - ((Par.passed_bonus_eg[sd][Rank(sq)] * Dist.bonus[sq][p->mKingSq[op]]) / 30)
-                     + ((Par.passed_bonus_eg[sd][Rank(sq)] * Dist.bonus[sq][p->mKingSq[sd]]) / 90);
+        // in the midgame, we use just a bonus from the table
+        // in the endgame, passed pawn attracts both kings.
 
-            mg_tot += (mg_tmp * mul) / 100;
-            eg_tot += (eg_tmp * mul) / 100;
-        }
+        mg_tmp = Par.passed_bonus_mg[sd][Rank(sq)];
+        eg_tmp = Par.passed_bonus_eg[sd][Rank(sq)]
+                 - ((Par.passed_bonus_eg[sd][Rank(sq)] * Dist.bonus[sq][p->mKingSq[op]]) / 30)
+                 + ((Par.passed_bonus_eg[sd][Rank(sq)] * Dist.bonus[sq][p->mKingSq[sd]]) / 90);
+
+        mg_tot += (mg_tmp * mul) / 100;
+        eg_tot += (eg_tmp * mul) / 100;
     }
 
     Add(e, sd, (mg_tot * V(W_PASSERS)) / 100, (eg_tot * V(W_PASSERS)) / 100);
@@ -531,18 +696,16 @@ void cEngine::EvaluateUnstoppable(eData *e, POS *p) {
     if (p->mCnt[BC][N] + p->mCnt[BC][B] + p->mCnt[BC][R] + p->mCnt[BC][Q] == 0) {
         king_sq = p->KingSq(BC);
         if (p->mSide == BC) tempo = 1; else tempo = 0;
-        bb_pieces = p->Pawns(WC);
+        bb_pieces = e->passers[WC];
         while (bb_pieces) {
             sq = PopFirstBit(&bb_pieces);
-            if (!(Mask.passed[WC][sq] & p->Pawns(BC))) {
-                bb_span = BB.GetFrontSpan(SqBb(sq), WC);
-                pawn_sq = ((WC - 1) & 56) + (sq & 7);
-                prom_dist = Min(5, Dist.metric[sq][pawn_sq]);
-
-                if (prom_dist < (Dist.metric[king_sq][pawn_sq] - tempo)) {
-                    if (bb_span & p->Kings(WC)) prom_dist++;
-                    w_dist = Min(w_dist, prom_dist);
-                }
+            bb_span = BB.GetFrontSpan(SqBb(sq), WC);
+            pawn_sq = ((WC - 1) & 56) + (sq & 7);
+            prom_dist = Min(5, Dist.metric[sq][pawn_sq]);
+
+            if (prom_dist < (Dist.metric[king_sq][pawn_sq] - tempo)) {
+                if (bb_span & p->Kings(WC)) prom_dist++;
+                w_dist = Min(w_dist, prom_dist);
             }
         }
     }
@@ -552,18 +715,16 @@ void cEngine::EvaluateUnstoppable(eData *e, POS *p) {
     if (p->mCnt[WC][N] + p->mCnt[WC][B] + p->mCnt[WC][R] + p->mCnt[WC][Q] == 0) {
         king_sq = p->KingSq(WC);
         if (p->mSide == WC) tempo = 1; else tempo = 0;
-        bb_pieces = p->Pawns(BC);
+        bb_pieces = e->passers[BC];
         while (bb_pieces) {
             sq = PopFirstBit(&bb_pieces);
-            if (!(Mask.passed[BC][sq] & p->Pawns(WC))) {
-                bb_span = BB.GetFrontSpan(SqBb(sq), BC);
-                pawn_sq = ((BC - 1) & 56) + (sq & 7);
-                prom_dist = Min(5, Dist.metric[sq][pawn_sq]);
-
-                if (prom_dist < (Dist.metric[king_sq][pawn_sq] - tempo)) {
-                    if (bb_span & p->Kings(BC)) prom_dist++;
-                    b_dist = Min(b_dist, prom_dist);
-                }
+            bb_span = BB.GetFrontSpan(SqBb(sq), BC);
+            pawn_sq = ((BC - 1) & 56) + (sq & 7);
+            prom_dist = Min(5, Dist.metric[sq][pawn_sq]);
+
+            if (prom_dist < (Dist.metric[king_sq][pawn_sq] - tempo)) {
+                if (bb_span & p->Kings(BC)) prom_dist++;
+                b_dist = Min(b_dist, prom_dist);
             }
         }
     }
@@ -575,38 +736,37 @@ void cEngine::EvaluateUnstoppable(eData *e, POS *p) {
 
 void cEngine::Add(eData *e, eColor sd, int mg_val, int eg_val) {
 
-    e->mg[sd] += mg_val;
-    e->eg[sd] += eg_val;
+    e->sc[sd] += S(mg_val, eg_val);
 }
 
 void cEngine::Add(eData *e, eColor sd, int val) {
 
-    e->mg[sd] += val;
-    e->eg[sd] += val;
+    e->sc[sd] += S(val, val);
 }
 
 void cEngine::AddPawns(eData *e, eColor sd, int mg_val, int eg_val) {
 
-    e->mg_pawns[sd] += mg_val;
-    e->eg_pawns[sd] += eg_val;
+    e->pawns[sd] += S(mg_val, eg_val);
 }
 
 int cEngine::Interpolate(POS *p, eData *e) {
 
-    int mg_tot = e->mg[WC] - e->mg[BC];
-    int eg_tot = e->eg[WC] - e->eg[BC];
+    tScore tot = e->sc[WC] - e->sc[BC];
+    int mg_tot = MgScore(tot);
+    int eg_tot = EgScore(tot);
     int mg_phase = Min(p->mPhase, 24);
     int eg_phase = 24 - mg_phase;
 
     return (mg_tot * mg_phase + eg_tot * eg_phase) / 24;
 }
 
-void cEngine::EvaluateThreats(POS *p, eData *e, eColor sd) {
+template<eColor sd>
+void cEngine::EvaluateThreats(POS *p, eData *e) {
 
     int pc, sq;
     int mg = 0;
     int eg = 0;
-    eColor op = ~sd;
+    constexpr eColor op = ~sd;
 
     U64 bb_undefended = p->mClBb[op];
     U64 bb_threatened = bb_undefended & e->p_takes[sd];
@@ -686,34 +846,44 @@ int cEngine::EvalScaleByDepth(POS *p, int ply, int eval) {
 }
 #endif
 
-int cEngine::Evaluate(POS *p, eData *e) {
+// Full evaluation. If a window is given (Quiesce() stand pat) and the cheap part of eval
+// (material, pst, pawn structure and imbalance) is more than LAZY_MARGIN outside of it,
+// a bound is returned instead and the rest of eval is skipped.
+
+int cEngine::Evaluate(POS *p, eData *e, int alpha, int beta) {
+
+    EVAL_PROFILE(EP_EVAL);
 
     // Try retrieving score from per-thread eval hashtable
 
-    int addr = p->mHashKey % EVAL_HASH_SIZE;
+    sEvalHashEntry *entry = NULL;
+
+    if (mEvalTT) {
+        EVAL_PROFILE(EP_HASH);
+        entry = &mEvalTT[p->mHashKey & mEvalHashMask];
+        mEvalHashProbes++;
 
-    if (mEvalTT[addr].key == p->mHashKey) {
-        int sc = mEvalTT[addr].score;
-        return p->mSide == WC ? sc : -sc;
+        if (entry->key == p->mHashKey) {
+            mEvalHashHits++;
+            EVAL_PROFILE_COUNT(hash_hits);
+            int sc = entry->score;
+            return p->mSide == WC ? sc : -sc;
+        }
     }
 
     // Clear eval data
 
-    e->mg[WC] = p->mMgSc[WC];
-    e->mg[BC] = p->mMgSc[BC];
-    e->eg[WC] = p->mEgSc[WC];
-    e->eg[BC] = p->mEgSc[BC];
+    e->sc[WC] = p->mPstSc[WC];
+    e->sc[BC] = p->mPstSc[BC];
 	e->att[WC] = e->att[BC] = 0;
 	e->wood[WC] = e->wood[BC] = 0;
 
-    // Init helper bitboards (pawn info)
+    // Pawn structure score and helper bitboards (pawn info), both might come from hash
 
-    e->p_takes[WC] = BB.GetWPControl(p->Pawns(WC));
-    e->p_takes[BC] = BB.GetBPControl(p->Pawns(BC));
-    e->p_can_take[WC] = BB.FillNorth(e->p_takes[WC]);
-    e->p_can_take[BC] = BB.FillSouth(e->p_takes[BC]);
-    e->two_pawns_take[WC] = BB.GetDoubleWPControl(p->Pawns(WC));
-    e->two_pawns_take[BC] = BB.GetDoubleBPControl(p->Pawns(BC));
+    {
+        EVAL_PROFILE(EP_PAWN_STRUCT);
+        EvaluatePawnStruct(p, e);
+    }
 
     // Init or clear attack maps
 
@@ -724,59 +894,105 @@ int cEngine::Evaluate(POS *p, eData *e) {
 
     // Run all the evaluation subroutines
 
-    EvaluateMaterial(p, e, WC);
-    EvaluateMaterial(p, e, BC);
-    EvaluatePieces(p, e, WC);
-    EvaluatePieces(p, e, BC);
-    EvaluatePawnStruct(p, e);
-    EvaluatePassers(p, e, WC);
-    EvaluatePassers(p, e, BC);
-    EvaluateUnstoppable(e, p);
-    EvaluateThreats(p, e, WC);
-    EvaluateThreats(p, e, BC);
+    const sMaterialEntry *me;
+    {
+        EVAL_PROFILE(EP_MATERIAL);
+        me = ProbeMaterial(p);
+    }
+    Add(e, WC, me->material[WC]);
+    Add(e, BC, me->material[BC]);
+
+#ifdef USE_LAZY_EVAL
+
+    // Lazy eval, unless endgame scaling might change the score or
+    // eval blur (weakening noise) has to be added to the full score
+
+    bool lazy_exit = false;
+    int lazy_score = 0;
+
+    if ((alpha > -INF || beta < INF)
+    && !Par.eval_blur
+    && !me->endgame && !me->scale[WC] && !me->scale[BC]
+    && me->draw_factor[WC] == 64 && me->draw_factor[BC] == 64) {
+
+        EVAL_PROFILE(EP_LAZY);
+        eData lazy;
+        lazy.sc[WC] = e->sc[WC] + e->pawns[WC];
+        lazy.sc[BC] = e->sc[BC] + e->pawns[BC];
+        lazy.sc[Par.prog_side] += S(me->keep[Par.prog_side], 0);
+
+        int est = Interpolate(p, &lazy) + me->piece_value + me->imbalance;
+        if (p->mSide == BC) est = -est;
+
+        if (est - LAZY_MARGIN >= beta || est + LAZY_MARGIN <= alpha) {
+            lazy_exit = true;
+            lazy_score = est >= beta ? est - LAZY_MARGIN : est + LAZY_MARGIN;
+        }
+
+#ifdef USE_LAZY_EVAL_STATS
+        if (lazy_exit) mLazyExits++;
+#else
+        if (lazy_exit) {
+            EVAL_PROFILE_COUNT(lazy_exits);
+            return lazy_score;
+        }
+#endif
+    }
+#endif
+    {
+        EVAL_PROFILE(EP_PIECES);
+        EvaluatePieces<WC>(p, e);
+        EvaluatePieces<BC>(p, e);
+    }
+    {
+        EVAL_PROFILE(EP_PASSERS);
+        EvaluatePassers<WC>(p, e);
+        EvaluatePassers<BC>(p, e);
+    }
+    {
+        EVAL_PROFILE(EP_UNSTOPPABLE);
+        EvaluateUnstoppable(e, p);
+    }
+    if (!(Par.skip_terms[WC] & ET_THREATS)) {
+        EVAL_PROFILE(EP_THREATS);
+        EvaluateThreats<WC>(p, e);
+        EvaluateThreats<BC>(p, e);
+    }
     Add(e, p->mSide, 14, 7); // tempo bonus
 
-    // Evaluate patterns
+    // Evaluate patterns (skipping those whose values are all zero)
 
-    EvaluateKnightPatterns(p, e);
-    EvaluateBishopPatterns(p, e);
-    EvaluateKingPatterns(p, e);
-    EvaluateCentralPatterns(p, e);
+    {
+        EVAL_PROFILE(EP_PATTERNS);
+        int skip = Par.skip_terms[WC];
+        if (!(skip & ET_KNIGHT_PAT)) EvaluateKnightPatterns(p, e);
+        if (!(skip & ET_BISHOP_PAT)) EvaluateBishopPatterns(p, e);
+        if (!(skip & ET_KING_PAT)) EvaluateKingPatterns(p, e);
+        if (!(skip & ET_CENTRAL_PAT)) EvaluateCentralPatterns(p, e);
+    }
 
-	EvaluateKingAttack(p, e, WC);
-	EvaluateKingAttack(p, e, BC);
+    {
+        EVAL_PROFILE(EP_KING_ATTACK);
+        EvaluateKingAttack(p, e, WC);
+        EvaluateKingAttack(p, e, BC);
+    }
 
     // Add pawn score (which might come from hash)
 
-    e->mg[WC] += e->mg_pawns[WC];
-    e->mg[BC] += e->mg_pawns[BC];
-    e->eg[WC] += e->eg_pawns[WC];
-    e->eg[BC] += e->eg_pawns[BC];
+    e->sc[WC] += e->pawns[WC];
+    e->sc[BC] += e->pawns[BC];
 
     // Add asymmetric bonus for keeping certain type of pieces
 
-    e->mg[Par.prog_side] += Par.keep_pc[Q] * p->mCnt[Par.prog_side][Q];
-    e->mg[Par.prog_side] += Par.keep_pc[R] * p->mCnt[Par.prog_side][R];
-    e->mg[Par.prog_side] += Par.keep_pc[B] * p->mCnt[Par.prog_side][B];
-    e->mg[Par.prog_side] += Par.keep_pc[N] * p->mCnt[Par.prog_side][N];
-    e->mg[Par.prog_side] += Par.keep_pc[P] * p->mCnt[Par.prog_side][P];
+    e->sc[Par.prog_side] += S(me->keep[Par.prog_side], 0);
 
     // Interpolate between midgame and endgame scores
 
-    int score = Interpolate(p, e);
+    int score = Interpolate(p, e) + me->piece_value;
 
     // Material imbalance evaluation (based on Crafty)
 
-    int minor_balance = p->mCnt[WC][N] - p->mCnt[BC][N] + p->mCnt[WC][B] - p->mCnt[BC][B];
-    int major_balance = p->mCnt[WC][R] - p->mCnt[BC][R] + 2 * p->mCnt[WC][Q] - 2 * p->mCnt[BC][Q];
-
-    int x = Max(major_balance + 4, 0);
-    if (x > 8) x = 8;
-
-    int y = Max(minor_balance + 4, 0);
-    if (y > 8) y = 8;
-
-    score += Par.imbalance[x][y];
+    score += me->imbalance;
 
     // Weakening: add pseudo-random value to eval score
 
@@ -787,13 +1003,17 @@ int cEngine::Evaluate(POS *p, eData *e) {
 
     // Special case code for KBN vs K checkmate
 
-    score += CheckmateHelper(p);
+    if (me->endgame)
+        score += me->endgame(p);
 
     // Decrease score for drawish endgames
 
     int draw_factor = 64;
-    if (score > 0) draw_factor = GetDrawFactor(p, WC);
-    if (score < 0) draw_factor = GetDrawFactor(p, BC);
+    if (score != 0) {
+        EVAL_PROFILE(EP_DRAW_FACTOR);
+        eColor sd = score > 0 ? WC : BC;
+        draw_factor = me->scale[sd] ? me->scale[sd](p, sd, ~sd) : me->draw_factor[sd];
+    }
     score = (score * draw_factor) / 64;
 
 
@@ -801,10 +1021,24 @@ int cEngine::Evaluate(POS *p, eData *e) {
 
     score = Clip(score, MAX_EVAL);
 
+#ifdef USE_LAZY_EVAL_STATS
+
+    // Count lazy exits that would have returned a wrong bound
+
+    if (lazy_exit) {
+        int full_score = p->mSide == WC ? score : -score;
+        if ((lazy_score >= beta && full_score < beta)
+        ||  (lazy_score <= alpha && full_score > alpha))
+            mLazyErrors++;
+    }
+#endif
+
     // Save eval score in the evaluation hash table
 
-    mEvalTT[addr].key = p->mHashKey;
-    mEvalTT[addr].score = score;
+    if (entry) {
+        entry->key = p->mHashKey;
+        entry->score = score;
+    }
 
     // Return score relative to the side to move
 
@@ -60,79 +60,97 @@ static const int BN_bb[64] = {
     0,   0,   15,  30,  45,  60,  85, 100
 };
 
-int cEngine::GetDrawFactor(POS *p, eColor sd) {  // refactoring may be needed
+// Classifies material configuration from the point of view of stronger side sd. Draw factor
+// that follows from piece counts alone is stored directly, endgames that need to look
+// at piece placement get a scaling function instead. Result goes to the material hash.
+
+void cEngine::SetDrawFactor(POS *p, eColor sd, sMaterialEntry *me) {
 
     eColor op = ~sd; // weaker side
 
+    me->draw_factor[sd] = 64;
+    me->scale[sd] = NULL;
+
     if (p->mPhase < 2) {
-        if (p->Pawns(sd) == 0) return 0;                                                                   // KK, KmK, KmKp, KmKpp
+        if (p->mCnt[sd][P] == 0) { me->draw_factor[sd] = 0; return; }                                      // KK, KmK, KmKp, KmKpp
     }
 
-    if (p->mPhase == 0) return ScalePawnsOnly(p, sd, op);
+    if (p->mPhase == 0) { me->scale[sd] = ScalePawnsOnly; return; }
 
     if (p->mPhase == 1) {
-        if (p->mCnt[sd][B] == 1) return ScaleKBPK(p, sd, op);                                              // KBPK, see below
-        if (p->mCnt[sd][N] == 1) return ScaleKNPK(p, sd, op);                                              // KBPK, see below
+        if (p->mCnt[sd][B] == 1) { me->scale[sd] = ScaleKBPK; return; }                                    // KBPK, see below
+        if (p->mCnt[sd][N] == 1) { me->scale[sd] = ScaleKNPK; return; }                                    // KNPK, see below
     }
 
     if (p->mPhase == 2) {
 
         if (p->mCnt[sd][N] == 2 && p->mCnt[sd][P] == 0) {
-            if (p->mCnt[op][P] == 0) return 0;                                                             // KNNK(m)
-            else return 8;                                                                                 // KNNK(m)(p)
-        }
-
-        if (p->mCnt[sd][B] == 2 && p->mCnt[sd][P] == 0) {                                                  // KBBK, same coloured bishops
-            if (MoreThanOne(p->Bishops(sd) & bbWhiteSq)
-            ||  MoreThanOne(p->Bishops(sd) & bbBlackSq)) return 0;
+            if (p->mCnt[op][P] == 0) me->draw_factor[sd] = 0;                                              // KNNK(m)
+            else me->draw_factor[sd] = 8;                                                                  // KNNK(m)(p)
+            return;
         }
 
-        if (p->mCnt[sd][B] == 1                                                                            // KBPKm, king blocks
-        && p->mCnt[op][B] + p->mCnt[op][N] == 1
-        && p->mCnt[sd][P] == 1
-        && p->mCnt[op][P] == 0
-        && (SqBb(p->mKingSq[op]) & BB.GetFrontSpan(p->Pawns(sd), sd))
-        && NotOnBishColor(p, sd, p->mKingSq[op]))
-            return 0;
-
-        if (p->mCnt[sd][B] == 1 && p->mCnt[op][B] == 1
-        && DifferentBishops(p)) {
-            if (Mask.home[sd] & p->Pawns(sd)
-            &&  p->mCnt[sd][P] == 1 && p->mCnt[op][P] == 0) return 8;                                      // KBPKB, BOC, pawn on own half
-
-            return 32;                                                                                     // BOC, any number of pawns
-        }
+        if (p->mCnt[sd][B] > 0) me->scale[sd] = ScaleMinors;                                               // see below
+        return;
     }
 
     if (p->mPhase == 3 && p->mCnt[sd][P] == 0) {
-        if (p->mCnt[sd][R] == 1 && p->mCnt[op][B] + p->mCnt[op][N] == 1) return 16;                        // KRKm(p)
-        if (p->mCnt[sd][B] + p->mCnt[sd][N] == 2 && p->mCnt[op][B] == 1) return 8;                         // KmmKB(p)
-        if (p->mCnt[sd][B] == 1 && p->mCnt[sd][N] == 1 && p->mCnt[op][B] + p->mCnt[op][N] == 1) return 8;  // KBNKm(p)
+        if (p->mCnt[sd][R] == 1 && p->mCnt[op][B] + p->mCnt[op][N] == 1) { me->draw_factor[sd] = 16; return; }                       // KRKm(p)
+        if (p->mCnt[sd][B] + p->mCnt[sd][N] == 2 && p->mCnt[op][B] == 1) { me->draw_factor[sd] = 8; return; }                        // KmmKB(p)
+        if (p->mCnt[sd][B] == 1 && p->mCnt[sd][N] == 1 && p->mCnt[op][B] + p->mCnt[op][N] == 1) { me->draw_factor[sd] = 8; return; } // KBNKm(p)
     }
 
     if (p->mPhase == 4 && p->mCnt[sd][R] == 1 && p->mCnt[op][R] == 1) {
 
-        if (p->mCnt[sd][P] == 0 && p->mCnt[op][P] == 0) return 8;                                          // KRKR
-        if (p->mCnt[sd][P] == 1 && p->mCnt[op][P] == 0) return ScaleKRPKR(p, sd, op);                      // KRPKR, see below
+        if (p->mCnt[sd][P] == 0 && p->mCnt[op][P] == 0) { me->draw_factor[sd] = 8; return; }                // KRKR
+        if (p->mCnt[sd][P] == 1 && p->mCnt[op][P] == 0) { me->scale[sd] = ScaleKRPKR; return; }            // KRPKR, see below
     }
 
     if (p->mPhase == 5 && p->mCnt[sd][P] == 0) {
-        if (p->mCnt[sd][R] == 1 && p->mCnt[sd][B] + p->mCnt[sd][N] == 1 && p->mCnt[op][R] == 1) return 16; // KRMKR(p)
+        if (p->mCnt[sd][R] == 1 && p->mCnt[sd][B] + p->mCnt[sd][N] == 1 && p->mCnt[op][R] == 1) { me->draw_factor[sd] = 16; return; } // KRMKR(p)
     }
 
-    if (p->mPhase == 6 && p->mCnt[sd][Q] == 1 && p->mCnt[op][R] == 1 && p->mCnt[sd][P] == 0)
-        return ScaleKQKRP(p, sd, op);
+    if (p->mPhase == 6 && p->mCnt[sd][Q] == 1 && p->mCnt[op][R] == 1 && p->mCnt[sd][P] == 0) {
+        me->scale[sd] = ScaleKQKRP;
+        return;
+    }
 
     if (p->mPhase == 7 && p->mCnt[sd][P] == 0) {
-        if (p->mCnt[sd][R] == 2 && p->mCnt[op][B] + p->mCnt[op][N] == 1 && p->mCnt[op][R] == 1) return 16; // KRRKRm(p)
+        if (p->mCnt[sd][R] == 2 && p->mCnt[op][B] + p->mCnt[op][N] == 1 && p->mCnt[op][R] == 1) { me->draw_factor[sd] = 16; return; } // KRRKRm(p)
     }
 
     if (p->mPhase == 9 && p->mCnt[sd][P] == 0) {
-        if (p->mCnt[sd][R] == 2 && p->mCnt[sd][B] + p->mCnt[sd][N] == 1 && p->mCnt[op][R] == 2) return 16; // KRRMKRR(p)
-        if (p->mCnt[sd][Q] == 1 && p->mCnt[sd][B] + p->mCnt[sd][N] == 1 && p->mCnt[op][Q] == 1) return 16; // KQmKQ(p)
+        if (p->mCnt[sd][R] == 2 && p->mCnt[sd][B] + p->mCnt[sd][N] == 1 && p->mCnt[op][R] == 2) { me->draw_factor[sd] = 16; return; } // KRRMKRR(p)
+        if (p->mCnt[sd][Q] == 1 && p->mCnt[sd][B] + p->mCnt[sd][N] == 1 && p->mCnt[op][Q] == 1) { me->draw_factor[sd] = 16; return; } // KQmKQ(p)
     }
+}
+
+// Two minor pieces left on the board, stronger side has at least one bishop
+
+int cEngine::ScaleMinors(POS *p, eColor sd, eColor op) {
+
+    if (p->mCnt[sd][B] == 2 && p->mCnt[sd][P] == 0) {                                                      // KBBK, same coloured bishops
+        if (MoreThanOne(p->Bishops(sd) & bbWhiteSq)
+        ||  MoreThanOne(p->Bishops(sd) & bbBlackSq)) return 0;
+    }
+
+    if (p->mCnt[sd][B] == 1                                                                                // KBPKm, king blocks
+    && p->mCnt[op][B] + p->mCnt[op][N] == 1
+    && p->mCnt[sd][P] == 1
+    && p->mCnt[op][P] == 0
+    && (SqBb(p->mKingSq[op]) & BB.GetFrontSpan(p->Pawns(sd), sd))
+    && NotOnBishColor(p, sd, p->mKingSq[op]))
+        return 0;
 
-    return 64;
+    if (p->mCnt[sd][B] == 1 && p->mCnt[op][B] == 1
+    && DifferentBishops(p)) {
+        if (Mask.home[sd] & p->Pawns(sd)
+        &&  p->mCnt[sd][P] == 1 && p->mCnt[op][P] == 0) return 8;                                          // KBPKB, BOC, pawn on own half
+
+        return 32;                                                                                         // BOC, any number of pawns
+    }
+
+    return 64; // default
 }
 
 int cEngine::ScalePawnsOnly(POS *p, eColor sd, eColor op) {
@@ -272,6 +290,29 @@ bool cEngine::DifferentBishops(POS *p) {
     return false;
 }
 
+// Tells whether CheckmateHelper() can return non-zero score for this material
+
+bool cEngine::NeedsCheckmateHelper(POS *p) {
+
+    for (eColor sd = WC; sd < 2; ++sd) {
+        eColor op = ~sd;
+
+        if (p->mCnt[sd][Q] > 0 && p->mCnt[sd][P] == 0                                                      // KQ vs Kx
+        &&  p->mCnt[op][Q] == 0 && p->mCnt[op][P] == 0 && p->mCnt[op][R] + p->mCnt[op][B] + p->mCnt[op][N] <= 1)
+            return true;
+
+        if (p->mCnt[op][P] + p->mCnt[op][N] + p->mCnt[op][B] + p->mCnt[op][R] + p->mCnt[op][Q] == 0      // bare king
+        && ((p->mCnt[sd][Q] + p->mCnt[sd][R] > 0) || p->mCnt[sd][B] > 1))
+            return true;
+
+        if (p->mCnt[WC][P] == 0 && p->mCnt[BC][P] == 0 && p->mPhase == 2                                  // KBN vs K
+        &&  p->mCnt[sd][B] == 1 && p->mCnt[sd][N] == 1)
+            return true;
+    }
+
+    return false;
+}
+
 int cEngine::CheckmateHelper(POS *p) {
 
 	// TODO: make color-agnostic
@@ -284,7 +325,7 @@ int cEngine::CheckmateHelper(POS *p) {
 
             result += 200;
             result += 10 * Dist.bonus[p->mKingSq[WC]][p->mKingSq[BC]];
-            result -= Par.eg_pst[BC][K][p->mKingSq[BC]];
+            result -= EgScore(Par.pst[BC][K][p->mKingSq[BC]]);
             return result;
         }
     }
@@ -294,7 +335,7 @@ int cEngine::CheckmateHelper(POS *p) {
 
             result -= 200;
             result -= 10 * Dist.bonus[p->mKingSq[WC]][p->mKingSq[BC]];
-            result += Par.eg_pst[BC][K][p->mKingSq[BC]];
+            result += EgScore(Par.pst[BC][K][p->mKingSq[BC]]);
             return result;
         }
     }
@@ -305,7 +346,7 @@ int cEngine::CheckmateHelper(POS *p) {
         if ((p->mCnt[WC][Q] + p->mCnt[WC][R] > 0) || p->mCnt[WC][B] > 1) {
             result += 200;
             result += 10 * Dist.bonus[p->mKingSq[WC]][p->mKingSq[BC]];
-            result -= Par.eg_pst[BC][K][p->mKingSq[BC]];
+            result -= EgScore(Par.pst[BC][K][p->mKingSq[BC]]);
         }
     }
 
@@ -313,7 +354,7 @@ int cEngine::CheckmateHelper(POS *p) {
         if ((p->mCnt[BC][Q] + p->mCnt[BC][R] > 0) || p->mCnt[BC][B] > 1) {
             result -= 200;
             result -= 10 * Dist.bonus[p->mKingSq[WC]][p->mKingSq[BC]];
-            result += Par.eg_pst[BC][K][p->mKingSq[BC]];
+            result += EgScore(Par.pst[BC][K][p->mKingSq[BC]]);
         }
     }
 
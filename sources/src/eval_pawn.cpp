@@ -16,7 +16,9 @@ If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include "rodent.h"
+#include <cstdio>
 #include <cstring>
+#include <new>
 
 static const int empty_ks[64] = {
     0,   0,   0,   0,   0, -10, -20, -30,
@@ -40,45 +42,184 @@ static const int empty_qs[64] = {
   -30, -20, -10,   0,   0,   0,   0,   0
 };
 
+cSharedPawnHash SharedPawnTT;
+
+void cSharedPawnHash::Alloc(int kb) {
+
+    if (kb == mKb) return;
+
+    mKb = kb;
+    mTable.reset();
+    mMask = 0;
+
+    if (mKb <= 0) return;
+
+    U64 entries = 1;
+    while (entries * 2 * sizeof(sSharedPawnSlot) <= (U64)mKb * 1024)
+        entries *= 2;
+
+    mTable.reset(new (std::nothrow) sSharedPawnSlot[entries]);
+
+    if (!mTable) {
+        if (Glob.is_noisy)
+            printf("info string shared pawn hash allocation error\n");
+        mKb = 0;
+        return;
+    }
+
+    mMask = entries - 1;
+    Clear();
+}
+
+void cSharedPawnHash::Clear() {
+
+    for (U64 i = 0; mTable && i <= mMask; i++) {
+        mTable[i].check.store(0, std::memory_order_relaxed);
+        for (int j = 0; j < PAWN_DATA_WORDS; j++)
+            mTable[i].data[j].store(0, std::memory_order_relaxed);
+    }
+}
+
+bool cSharedPawnHash::Probe(U64 key, sPawnHashEntry *entry) const {
+
+    const sSharedPawnSlot *slot = &mTable[key & mMask];
+    U64 words[PAWN_DATA_WORDS];
+    U64 check = slot->check.load(std::memory_order_relaxed);
+
+    for (int j = 0; j < PAWN_DATA_WORDS; j++) {
+        words[j] = slot->data[j].load(std::memory_order_relaxed);
+        check ^= words[j];
+    }
+
+    if (check != key) return false;
+
+    entry->key = key;
+    memcpy((char *)entry + sizeof(U64), words, sizeof(words));
+    return true;
+}
+
+void cSharedPawnHash::Store(const sPawnHashEntry *entry) {
+
+    sSharedPawnSlot *slot = &mTable[entry->key & mMask];
+    U64 words[PAWN_DATA_WORDS];
+    U64 check = entry->key;
+
+    memcpy(words, (const char *)entry + sizeof(U64), sizeof(words));
+
+    for (int j = 0; j < PAWN_DATA_WORDS; j++) {
+        slot->data[j].store(words[j], std::memory_order_relaxed);
+        check ^= words[j];
+    }
+
+    slot->check.store(check, std::memory_order_relaxed);
+}
+
 void cEngine::ClearPawnHash() {
 
-    ZEROARRAY(mPawnTT);
+    if (mPawnTT)
+        memset(mPawnTT.get(), 0, (mPawnHashMask + 1) * sizeof(sPawnHashEntry));
+}
+
+// (Re)allocate pawn hash if PawnHashKB has changed, see AllocEvalHash()
+
+void cEngine::AllocPawnHash() {
+
+    int kb = SharedPawnTT.Enabled() ? 0 : Glob.pawn_hash_kb; // no private table next to a shared one
+
+    if (mPawnHashKb == kb) return;
+
+    mPawnHashKb = kb;
+    mPawnTT.reset();
+    mPawnHashMask = 0;
+
+    if (mPawnHashKb <= 0) return;
+
+    U64 entries = 1;
+    while (entries * 2 * sizeof(sPawnHashEntry) <= (U64)mPawnHashKb * 1024)
+        entries *= 2;
+
+    mPawnTT.reset(new (std::nothrow) sPawnHashEntry[entries]());
+
+    if (!mPawnTT) {
+        if (Glob.is_noisy)
+            printf("info string pawn hash allocation error\n");
+        return;
+    }
+
+    mPawnHashMask = entries - 1;
 }
 
 void cEngine::EvaluatePawnStruct(POS *p, eData *e) {
 
     // Try to retrieve score from pawn hashtable
 
-    int addr = p->mPawnKey % PAWN_HASH_SIZE;
+    sPawnHashEntry *entry = NULL;
+    sPawnHashEntry shared[1];
 
-    if (mPawnTT[addr].key == p->mPawnKey) {
+    if (SharedPawnTT.Enabled()) {
+        entry = shared;
+        mPawnHashProbes++;
+        if (!SharedPawnTT.Probe(p->mPawnKey, entry)) entry->key = 0;
+    } else if (mPawnTT) {
+        entry = &mPawnTT[p->mPawnKey & mPawnHashMask];
+        mPawnHashProbes++;
+    }
+
+    if (entry && entry->key == p->mPawnKey) {
+        mPawnHashHits++;
 
         // pawn hashtable contains delta of white and black score
 
-        e->mg_pawns[WC] = mPawnTT[addr].mg_pawns;
-        e->eg_pawns[WC] = mPawnTT[addr].eg_pawns;
-        e->mg_pawns[BC] = 0;
-        e->eg_pawns[BC] = 0;
+        e->pawns[WC] = entry->pawns;
+        e->pawns[BC] = 0;
+
+        // and pawn-derived bitboards used by the rest of eval
+
+        for (eColor sd = WC; sd < 2; ++sd) {
+            e->p_takes[sd] = entry->p_takes[sd];
+            e->p_can_take[sd] = entry->p_can_take[sd];
+            e->two_pawns_take[sd] = entry->two_pawns_take[sd];
+            e->passers[sd] = entry->passers[sd];
+            e->half_open[sd] = entry->half_open[sd];
+        }
         return;
     }
 
+    // Init helper bitboards (pawn info)
+
+    e->p_takes[WC] = BB.GetWPControl(p->Pawns(WC));
+    e->p_takes[BC] = BB.GetBPControl(p->Pawns(BC));
+    e->p_can_take[WC] = BB.FillNorth(e->p_takes[WC]);
+    e->p_can_take[BC] = BB.FillSouth(e->p_takes[BC]);
+    e->two_pawns_take[WC] = BB.GetDoubleWPControl(p->Pawns(WC));
+    e->two_pawns_take[BC] = BB.GetDoubleBPControl(p->Pawns(BC));
+
+    for (eColor sd = WC; sd < 2; ++sd) {
+        U64 bb_pawns = p->Pawns(sd);
+        e->half_open[sd] = ~(BB.FillNorth(bb_pawns) | BB.FillSouth(bb_pawns));
+        e->passers[sd] = 0;
+        while (bb_pawns) {
+            int sq = PopFirstBit(&bb_pawns);
+            if (!(Mask.passed[sd][sq] & p->Pawns(~sd)))
+                e->passers[sd] |= SqBb(sq);
+        }
+    }
+
     // Clear values
 
-    e->mg_pawns[WC] = 0;
-    e->mg_pawns[BC] = 0;
-    e->eg_pawns[WC] = 0;
-    e->eg_pawns[BC] = 0;
+    e->pawns[WC] = 0;
+    e->pawns[BC] = 0;
 
     // Pawn structure
 
-    EvaluatePawns(p, e, WC);
-    EvaluatePawns(p, e, BC);
+    EvaluatePawns<WC>(p, e);
+    EvaluatePawns<BC>(p, e);
 
     // King's pawn shield
     // (also includes pawn chains eval)
 
-    EvaluateKing(p, e, WC);
-    EvaluateKing(p, e, BC);
+    EvaluateKing<WC>(p, e);
+    EvaluateKing<BC>(p, e);
 
     // Center binds (good) and wing binds (bad)
     // - important squares controlled by two pawns
@@ -131,20 +272,30 @@ void cEngine::EvaluatePawnStruct(POS *p, eData *e) {
     const U64 b_pawns = p->Pawns(BC);
     const U64 b_pawn_files = BB.FillSouth(b_pawns) & 0xff;
     const int b_islands = PopCnt(((~b_pawn_files) >> 1) & b_pawn_files);
-    e->mg_pawns[WC] -= (w_islands - b_islands) * V(P_ISL);
-    e->eg_pawns[WC] -= (w_islands - b_islands) * V(P_ISL);
+    e->pawns[WC] -= S((w_islands - b_islands) * V(P_ISL), (w_islands - b_islands) * V(P_ISL));
     // pawn islands code would also break detailed score display
 
     // Save stuff in pawn hashtable.
     // Note that we save delta between white and black scores.
     // It might become a problem if we decide to print detailed eval score.
 
-    mPawnTT[addr].key = p->mPawnKey;
-    mPawnTT[addr].mg_pawns = (V(W_STRUCT) * (e->mg_pawns[WC] - e->mg_pawns[BC])) / 100;
-    mPawnTT[addr].eg_pawns = (V(W_STRUCT) * (e->eg_pawns[WC] - e->eg_pawns[BC])) / 100;
+    if (entry) {
+        entry->key = p->mPawnKey;
+        tScore delta = e->pawns[WC] - e->pawns[BC];
+        entry->pawns = S((V(W_STRUCT) * MgScore(delta)) / 100, (V(W_STRUCT) * EgScore(delta)) / 100);
+        for (eColor sd = WC; sd < 2; ++sd) {
+            entry->p_takes[sd] = e->p_takes[sd];
+            entry->p_can_take[sd] = e->p_can_take[sd];
+            entry->two_pawns_take[sd] = e->two_pawns_take[sd];
+            entry->passers[sd] = e->passers[sd];
+            entry->half_open[sd] = e->half_open[sd];
+        }
+        if (entry == shared) SharedPawnTT.Store(entry);
+    }
 }
 
-void cEngine::EvaluateKing(POS *p, eData *e, eColor sd) {
+template<eColor sd>
+void cEngine::EvaluateKing(POS *p, eData *e) {
 
     const int qCastle[2] = { B1, B8 };
     const int kCastle[2] = { G1, G8 };
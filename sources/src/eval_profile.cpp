@@ -0,0 +1,95 @@
+/*
+Rodent, a UCI chess playing engine derived from Sungorus 1.4
+Copyright (C) 2009-2011 Pablo Vazquez (Sungorus author)
+Copyright (C) 2011-2018 Pawel Koziol
+
+Rodent is free software: you can redistribute it and/or modify it under the terms of the GNU
+General Public License as published by the Free Software Foundation, either version 3 of the
+License, or (at your option) any later version.
+
+Rodent is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program.
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "rodent.h"
+
+#ifdef USE_EVAL_PROFILE
+
+#include <cstdio>
+#include <cstring>
+
+// Eval profile (compile with USE_EVAL_PROFILE). Evaluate() times itself and each of
+// its parts with cEvalTimer, see EVAL_PROFILE() in eval.cpp; every thread adds to its
+// own counters, which are kept over searches until `evalprofile clear`.
+//
+//   evalprofile        print calls and time per part, summed over threads
+//   evalprofile clear  reset the counters of all threads
+
+static const char *const part_names[EP_CNT] = {
+    "Evaluate (total)", "eval hash probe", "EvaluatePawnStruct", "ProbeMaterial", "lazy eval",
+    "EvaluatePieces", "EvaluatePassers", "EvaluateUnstoppable", "EvaluateThreats",
+    "patterns", "EvaluateKingAttack", "draw factor/scaling"
+};
+
+static void AddProfile(sEvalProfile &profile, sEvalProfile *sum, bool clear) {
+
+    for (int part = 0; part < EP_CNT; part++) {
+        sum->ticks[part] += profile.ticks[part];
+        sum->calls[part] += profile.calls[part];
+    }
+    sum->hash_hits += profile.hash_hits;
+    sum->lazy_exits += profile.lazy_exits;
+    if (clear) profile = sEvalProfile();
+}
+
+static double Percent(U64 part, U64 whole) {
+    return whole ? 100.0 * part / whole : 0.0;
+}
+
+void PrintEvalProfile(const char *ptr) {
+
+    char token[180];
+    sEvalProfile sum = {};
+    int threads = 0;
+
+    ParseToken(ptr, token);
+    const bool clear = strcmp(token, "clear") == 0;
+
+#ifndef USE_THREADS
+    AddProfile(EngineSingle.mEvalProfile, &sum, clear);
+    threads = 1;
+#else
+    for (cEngine &engine : Engines) {
+        AddProfile(engine.mEvalProfile, &sum, clear);
+        threads++;
+    }
+#endif
+    if (clear) return;
+
+    const U64 evals = sum.calls[EP_EVAL];
+    const U64 total = sum.ticks[EP_EVAL];
+    U64 parts = 0;
+
+    printf("eval profile, %d thread(s), time in " PROFILE_UNIT "\n", threads);
+    printf("%-22s %12s %9s %12s %9s\n", "part", "calls", "% evals", PROFILE_UNIT "/call", "% time");
+    for (int part = 0; part < EP_CNT; part++) {
+        printf("%-22s %12" PRIu64 " %8.1f%% %12.1f %8.1f%%\n", part_names[part], sum.calls[part],
+               Percent(sum.calls[part], evals), sum.calls[part] ? (double)sum.ticks[part] / sum.calls[part] : 0.0,
+               Percent(sum.ticks[part], total));
+        if (part != EP_EVAL) parts += sum.ticks[part];
+    }
+
+    // the rest is clearing eval data, interpolation, hash store and timer overhead
+
+    const U64 other = total > parts ? total - parts : 0;
+    printf("%-22s %12s %9s %12.1f %8.1f%%\n", "other", "", "", evals ? (double)other / evals : 0.0, Percent(other, total));
+    printf("eval hash: %" PRIu64 " probes, %.1f%% hits; lazy exits: %.1f%% of evaluations\n",
+           sum.calls[EP_HASH], Percent(sum.hash_hits, sum.calls[EP_HASH]), Percent(sum.lazy_exits, evals));
+}
+
+#endif // USE_EVAL_PROFILE
@@ -19,104 +19,65 @@ If not, see <http://www.gnu.org/licenses/>.
 
 int *POS::GenerateCaptures(int *list) const {
 
-    U64 bb_pieces, bb_moves;
-    int from, to;
-
-    eColor sd = mSide;
-    eColor op = ~sd;
-
-    if (sd == WC) {
-        bb_moves = ((Pawns(WC) & ~FILE_A_BB & RANK_7_BB) << 7) & mClBb[BC];
-        while (bb_moves) {
-            to = PopFirstBit(&bb_moves);
-            *list++ = (Q_PROM << 12) | (to << 6) | (to - 7);
-            *list++ = (R_PROM << 12) | (to << 6) | (to - 7);
-            *list++ = (B_PROM << 12) | (to << 6) | (to - 7);
-            *list++ = (N_PROM << 12) | (to << 6) | (to - 7);
-        }
-
-        bb_moves = ((Pawns(WC) & ~FILE_H_BB & RANK_7_BB) << 9) & mClBb[BC];
-        while (bb_moves) {
-            to = PopFirstBit(&bb_moves);
-            *list++ = (Q_PROM << 12) | (to << 6) | (to - 9);
-            *list++ = (R_PROM << 12) | (to << 6) | (to - 9);
-            *list++ = (B_PROM << 12) | (to << 6) | (to - 9);
-            *list++ = (N_PROM << 12) | (to << 6) | (to - 9);
-        }
+    return mSide == WC ? GenerateCaptures<WC>(list) : GenerateCaptures<BC>(list);
+}
 
-        bb_moves = ((Pawns(WC) & RANK_7_BB) << 8) & UnoccBb();
-        while (bb_moves) {
-            to = PopFirstBit(&bb_moves);
-            *list++ = (Q_PROM << 12) | (to << 6) | (to - 8);
-            *list++ = (R_PROM << 12) | (to << 6) | (to - 8);
-            *list++ = (B_PROM << 12) | (to << 6) | (to - 8);
-            *list++ = (N_PROM << 12) | (to << 6) | (to - 8);
-        }
+template<eColor sd>
+int *POS::GenerateCaptures(int *list) const {
 
-        bb_moves = ((Pawns(WC) & ~FILE_A_BB & ~RANK_7_BB) << 7) & mClBb[BC];
-        while (bb_moves) {
-            to = PopFirstBit(&bb_moves);
-            *list++ = (to << 6) | (to - 7);
-        }
+    U64 bb_pieces, bb_moves;
+    int from, to;
 
-        bb_moves = ((Pawns(WC) & ~FILE_H_BB & ~RANK_7_BB) << 9) & mClBb[BC];
-        while (bb_moves) {
-            to = PopFirstBit(&bb_moves);
-            *list++ = (to << 6) | (to - 9);
-        }
+    constexpr eColor op = ~sd;
+    constexpr U64 bb_rank_7 = bb_rel_rank[sd][RANK_7];
+    constexpr int fwd  = sd == WC ? 8 : -8;  // square delta of a pawn push
+    constexpr int west = sd == WC ? 7 : -9;  // ...of a pawn capture towards the a-file
+    constexpr int east = sd == WC ? 9 : -7;  // ...and towards the h-file
 
-        if ((to = mEpSq) != NO_SQ) {
-            if (((Pawns(WC) & ~FILE_A_BB) << 7) & SqBb(to))
-                *list++ = (EP_CAP << 12) | (to << 6) | (to - 7);
-            if (((Pawns(WC) & ~FILE_H_BB) << 9) & SqBb(to))
-                *list++ = (EP_CAP << 12) | (to << 6) | (to - 9);
-        }
-    } else {
-        bb_moves = ((Pawns(BC) & ~FILE_A_BB & RANK_2_BB) >> 9) & mClBb[WC];
-        while (bb_moves) {
-            to = PopFirstBit(&bb_moves);
-            *list++ = (Q_PROM << 12) | (to << 6) | (to + 9);
-            *list++ = (R_PROM << 12) | (to << 6) | (to + 9);
-            *list++ = (B_PROM << 12) | (to << 6) | (to + 9);
-            *list++ = (N_PROM << 12) | (to << 6) | (to + 9);
-        }
+    bb_moves = PawnCaptWest<sd>(Pawns(sd) & bb_rank_7) & mClBb[op];
+    while (bb_moves) {
+        to = PopFirstBit(&bb_moves);
+        *list++ = (Q_PROM << 12) | (to << 6) | (to - west);
+        *list++ = (R_PROM << 12) | (to << 6) | (to - west);
+        *list++ = (B_PROM << 12) | (to << 6) | (to - west);
+        *list++ = (N_PROM << 12) | (to << 6) | (to - west);
+    }
 
-        bb_moves = ((Pawns(BC) & ~FILE_H_BB & RANK_2_BB) >> 7) & mClBb[WC];
-        while (bb_moves) {
-            to = PopFirstBit(&bb_moves);
-            *list++ = (Q_PROM << 12) | (to << 6) | (to + 7);
-            *list++ = (R_PROM << 12) | (to << 6) | (to + 7);
-            *list++ = (B_PROM << 12) | (to << 6) | (to + 7);
-            *list++ = (N_PROM << 12) | (to << 6) | (to + 7);
-        }
+    bb_moves = PawnCaptEast<sd>(Pawns(sd) & bb_rank_7) & mClBb[op];
+    while (bb_moves) {
+        to = PopFirstBit(&bb_moves);
+        *list++ = (Q_PROM << 12) | (to << 6) | (to - east);
+        *list++ = (R_PROM << 12) | (to << 6) | (to - east);
+        *list++ = (B_PROM << 12) | (to << 6) | (to - east);
+        *list++ = (N_PROM << 12) | (to << 6) | (to - east);
+    }
 
-        bb_moves = ((Pawns(BC) & RANK_2_BB) >> 8) & UnoccBb();
-        while (bb_moves) {
-            to = PopFirstBit(&bb_moves);
-            *list++ = (Q_PROM << 12) | (to << 6) | (to + 8);
-            *list++ = (R_PROM << 12) | (to << 6) | (to + 8);
-            *list++ = (B_PROM << 12) | (to << 6) | (to + 8);
-            *list++ = (N_PROM << 12) | (to << 6) | (to + 8);
-        }
+    bb_moves = ShiftFwd<sd>(Pawns(sd) & bb_rank_7) & UnoccBb();
+    while (bb_moves) {
+        to = PopFirstBit(&bb_moves);
+        *list++ = (Q_PROM << 12) | (to << 6) | (to - fwd);
+        *list++ = (R_PROM << 12) | (to << 6) | (to - fwd);
+        *list++ = (B_PROM << 12) | (to << 6) | (to - fwd);
+        *list++ = (N_PROM << 12) | (to << 6) | (to - fwd);
+    }
 
-        bb_moves = ((Pawns(BC) & ~FILE_A_BB & ~RANK_2_BB) >> 9) & mClBb[WC];
-        while (bb_moves) {
-            to = PopFirstBit(&bb_moves);
-            *list++ = (to << 6) | (to + 9);
-        }
+    bb_moves = PawnCaptWest<sd>(Pawns(sd) & ~bb_rank_7) & mClBb[op];
+    while (bb_moves) {
+        to = PopFirstBit(&bb_moves);
+        *list++ = (to << 6) | (to - west);
+    }
 
-        bb_moves = ((Pawns(BC) & ~FILE_H_BB & ~RANK_2_BB) >> 7) & mClBb[WC];
-        while (bb_moves) {
-            to = PopFirstBit(&bb_moves);
-            *list++ = (to << 6) | (to + 7);
-        }
+    bb_moves = PawnCaptEast<sd>(Pawns(sd) & ~bb_rank_7) & mClBb[op];
+    while (bb_moves) {
+        to = PopFirstBit(&bb_moves);
+        *list++ = (to << 6) | (to - east);
+    }
 
-        if ((to = mEpSq) != NO_SQ) {
-            if (((Pawns(BC) & ~FILE_A_BB) >> 9) & SqBb(to))
-                *list++ = (EP_CAP << 12) | (to << 6) | (to + 9);
-            if (((Pawns(BC) & ~FILE_H_BB) >> 7) & SqBb(to))
-                *list++ = (EP_CAP << 12) | (to << 6) | (to + 7);
-        }
+    if ((to = mEpSq) != NO_SQ) {
+        if (PawnCaptWest<sd>(Pawns(sd)) & SqBb(to))
+            *list++ = (EP_CAP << 12) | (to << 6) | (to - west);
+        if (PawnCaptEast<sd>(Pawns(sd)) & SqBb(to))
+            *list++ = (EP_CAP << 12) | (to << 6) | (to - east);
     }
 
     // KNIGHT
@@ -124,7 +85,7 @@ int *POS::GenerateCaptures(int *list) const {
     bb_pieces = Knights(sd);
     while (bb_pieces) {
         from = PopFirstBit(&bb_pieces);
-        bb_moves = BB.KnightAttacks(from) & mClBb[~sd];
+        bb_moves = BB.KnightAttacks(from) & mClBb[op];
         while (bb_moves) {
             to = PopFirstBit(&bb_moves);
             *list++ = (to << 6) | from;
@@ -177,13 +138,21 @@ int *POS::GenerateCaptures(int *list) const {
     return list;
 }
 
+int *POS::GenerateQuiet(int *list) const {
+
+    return mSide == WC ? GenerateQuiet<WC>(list) : GenerateQuiet<BC>(list);
+}
+
+template<eColor sd>
 int *POS::GenerateQuiet(int *list) const {
 
     U64 bb_pieces, bb_moves;
-	eColor sd;
     int from, to;
 
-    sd = mSide;
+    constexpr U64 bb_rank_2 = bb_rel_rank[sd][RANK_2];
+    constexpr U64 bb_rank_7 = bb_rel_rank[sd][RANK_7];
+    constexpr int fwd = sd == WC ? 8 : -8;
+
     if (sd == WC) {
         if ((mCFlags & W_KS) && !(OccBb() & (U64)0x0000000000000060))
             if (!Attacked(E1, BC) && !Attacked(F1, BC))
@@ -191,18 +160,6 @@ int *POS::GenerateQuiet(int *list) const {
         if ((mCFlags & W_QS) && !(OccBb() & (U64)0x000000000000000E))
             if (!Attacked(E1, BC) && !Attacked(D1, BC))
                 *list++ = (CASTLE << 12) | (C1 << 6) | E1;
-
-        bb_moves = ((((Pawns(WC) & RANK_2_BB) << 8) & UnoccBb()) << 8) & UnoccBb();
-        while (bb_moves) {
-            to = PopFirstBit(&bb_moves);
-            *list++ = (EP_SET << 12) | (to << 6) | (to - 16);
-        }
-
-        bb_moves = ((Pawns(WC) & ~RANK_7_BB) << 8) & UnoccBb();
-        while (bb_moves) {
-            to = PopFirstBit(&bb_moves);
-            *list++ = (to << 6) | (to - 8);
-        }
     } else {
         if ((mCFlags & B_KS) && !(OccBb() & (U64)0x6000000000000000))
             if (!Attacked(E8, WC) && !Attacked(F8, WC))
@@ -210,18 +167,18 @@ int *POS::GenerateQuiet(int *list) const {
         if ((mCFlags & B_QS) && !(OccBb() & (U64)0x0E00000000000000))
             if (!Attacked(E8, WC) && !Attacked(D8, WC))
                 *list++ = (CASTLE << 12) | (C8 << 6) | E8;
+    }
 
-        bb_moves = ((((Pawns(BC) & RANK_7_BB) >> 8) & UnoccBb()) >> 8) & UnoccBb();
-        while (bb_moves) {
-            to = PopFirstBit(&bb_moves);
-            *list++ = (EP_SET << 12) | (to << 6) | (to + 16);
-        }
+    bb_moves = ShiftFwd<sd>(ShiftFwd<sd>(Pawns(sd) & bb_rank_2) & UnoccBb()) & UnoccBb();
+    while (bb_moves) {
+        to = PopFirstBit(&bb_moves);
+        *list++ = (EP_SET << 12) | (to << 6) | (to - 2 * fwd);
+    }
 
-        bb_moves = ((Pawns(BC) & ~RANK_2_BB) >> 8) & UnoccBb();
-        while (bb_moves) {
-            to = PopFirstBit(&bb_moves);
-            *list++ = (to << 6) | (to + 8);
-        }
+    bb_moves = ShiftFwd<sd>(Pawns(sd) & ~bb_rank_7) & UnoccBb();
+    while (bb_moves) {
+        to = PopFirstBit(&bb_moves);
+        *list++ = (to << 6) | (to - fwd);
     }
 
     // KNIGHT
@@ -282,12 +239,21 @@ int *POS::GenerateQuiet(int *list) const {
     return list;
 }
 
+int *POS::GenerateSpecial(int *list) const {
+
+    return mSide == WC ? GenerateSpecial<WC>(list) : GenerateSpecial<BC>(list);
+}
+
+template<eColor sd>
 int *POS::GenerateSpecial(int *list) const {
 
     U64 bb_pieces, bb_moves;
     int from, to;
-    eColor sd = mSide;
-    eColor op = ~sd;
+
+    constexpr eColor op = ~sd;
+    constexpr U64 bb_rank_2 = bb_rel_rank[sd][RANK_2];
+    constexpr U64 bb_rank_7 = bb_rel_rank[sd][RANK_7];
+    constexpr int fwd = sd == WC ? 8 : -8;
 
     // squares from which normal (non-discovered) checks are possible
 
@@ -295,39 +261,22 @@ int *POS::GenerateSpecial(int *list) const {
     U64 n_check = BB.KnightAttacks(king_sq);
     U64 r_check = BB.RookAttacks(OccBb(), king_sq);
     U64 b_check = BB.BishAttacks(OccBb(), king_sq);
-    U64 p_check = BB.ShiftFwd(BB.ShiftSideways(SqBb(king_sq)), op);
+    U64 p_check = ShiftFwd<op>(BB.ShiftSideways(SqBb(king_sq)));
 
     // TODO: discovered checks by a pawn
 
-    if (sd == WC) {
-
-        bb_moves = ((((Pawns(WC) & RANK_2_BB) << 8) & UnoccBb()) << 8) & UnoccBb();
-        bb_moves = bb_moves & p_check;
-        while (bb_moves) {
-            to = PopFirstBit(&bb_moves);
-            *list++ = (EP_SET << 12) | (to << 6) | (to - 16);
-        }
-
-        bb_moves = ((Pawns(WC) & ~RANK_7_BB) << 8) & UnoccBb();
-        bb_moves = bb_moves & p_check;
-        while (bb_moves) {
-            to = PopFirstBit(&bb_moves);
-            *list++ = (to << 6) | (to - 8);
-        }
-    } else {
-        bb_moves = ((((Pawns(BC) & RANK_7_BB) >> 8) & UnoccBb()) >> 8) & UnoccBb();
-        bb_moves = bb_moves & p_check;
-        while (bb_moves) {
-            to = PopFirstBit(&bb_moves);
-            *list++ = (EP_SET << 12) | (to << 6) | (to + 16);
-        }
+    bb_moves = ShiftFwd<sd>(ShiftFwd<sd>(Pawns(sd) & bb_rank_2) & UnoccBb()) & UnoccBb();
+    bb_moves = bb_moves & p_check;
+    while (bb_moves) {
+        to = PopFirstBit(&bb_moves);
+        *list++ = (EP_SET << 12) | (to << 6) | (to - 2 * fwd);
+    }
 
-        bb_moves = ((Pawns(BC) & ~RANK_2_BB) >> 8) & UnoccBb();
-        bb_moves = bb_moves & p_check;
-        while (bb_moves) {
-            to = PopFirstBit(&bb_moves);
-            *list++ = (to << 6) | (to + 8);
-        }
+    bb_moves = ShiftFwd<sd>(Pawns(sd) & ~bb_rank_7) & UnoccBb();
+    bb_moves = bb_moves & p_check;
+    while (bb_moves) {
+        to = PopFirstBit(&bb_moves);
+        *list++ = (to << 6) | (to - fwd);
     }
 
     // KNIGHT
@@ -415,7 +364,7 @@ bool POS::CanDiscoverCheck(U64 bb_checkers, eColor op, int from) const {
 
     while (bb_checkers) {
         int checker = PopFirstBit(&bb_checkers);
-        U64 bb_ray = BB.bbBetween[checker][mKingSq[op]];
+        U64 bb_ray = BB.Between(checker, mKingSq[op]);
 
         if (SqBb(from) & bb_ray) {
             if (PopCnt(bb_ray & OccBb()) == 1)
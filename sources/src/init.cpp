@@ -17,7 +17,9 @@ If not, see <http://www.gnu.org/licenses/>.
 
 #include <random>
 #include <cmath>
+#include <cassert>
 #include <string.h>
+#include <utility>
 #include "rodent.h"
 
 std::mt19937_64 e2(2018);
@@ -39,11 +41,55 @@ void POS::Init() { // static init function
     msCastleMask[E8] = W_KS | W_QS              ;
     msCastleMask[H8] = W_KS | W_QS        | B_QS;
 
-    for (int i = 0; i < 12; i++)
-        for (int j = 0; j < 64; j++)
-            msZobPiece[i][j] = Random64();
-    for (int i = 0; i < 16; i++)
-        msZobCastle[i] = Random64();
-    for (int i = 0; i < 8; i++)
-        msZobEp[i] = Random64();
+    // zobrist keys are generated in zobrist.h
+
+    InitCuckoo();
+}
+
+// Cuckoo tables of hash key differences caused by reversible piece moves
+// (Marcel van Kervinck's method, as used in Stockfish). They let HasGameCycle()
+// find a move leading back to an earlier position without generating moves.
+// Needs BB.Init() and zobrist keys.
+
+void POS::InitCuckoo() {
+
+    int count = 0;
+
+    for (int i = 0; i < CUCKOO_SIZE; i++) {
+        msCuckooKey[i] = 0;
+        msCuckooMove[i] = 0;
+    }
+
+    for (int pc = 0; pc < 12; pc++) {
+        int tp = Tp(pc);
+        if (tp == P) continue;
+
+        for (int s1 = 0; s1 < 64; s1++) {
+            U64 bb_att = tp == N ? BB.KnightAttacks(s1)
+                       : tp == B ? BB.BishAttacks(0, s1)
+                       : tp == R ? BB.RookAttacks(0, s1)
+                       : tp == Q ? BB.QueenAttacks(0, s1)
+                       :           BB.KingAttacks(s1);
+
+            for (int s2 = s1 + 1; s2 < 64; s2++) {
+                if (!(bb_att & SqBb(s2))) continue;
+
+                int move = (s2 << 6) | s1;
+                U64 key = msZobPiece[pc][s1] ^ msZobPiece[pc][s2] ^ SIDE_RANDOM;
+                int i = CuckooH1(key);
+
+                // insert, kicking out entries to their alternative slot
+
+                for (;;) {
+                    std::swap(msCuckooKey[i], key);
+                    std::swap(msCuckooMove[i], move);
+                    if (move == 0) break;
+                    i = (i == CuckooH1(key)) ? CuckooH2(key) : CuckooH1(key);
+                }
+                count++;
+            }
+        }
+    }
+
+    assert(count == 3668);
 }
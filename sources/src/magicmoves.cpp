@@ -30,7 +30,7 @@
 
 #include "magicmoves.h"
 
-const unsigned int magicmoves_r_shift[64] = {
+constexpr unsigned int magicmoves_r_shift[64] = {
     52, 53, 53, 53, 53, 53, 53, 52,
     53, 54, 54, 54, 54, 54, 54, 53,
     53, 54, 54, 54, 54, 54, 54, 53,
@@ -41,7 +41,7 @@ const unsigned int magicmoves_r_shift[64] = {
     53, 54, 54, 53, 53, 53, 53, 53
 };
 
-const U64 magicmoves_r_magics[64] = {
+constexpr U64 magicmoves_r_magics[64] = {
     C64(0x0080001020400080), C64(0x0040001000200040), C64(0x0080081000200080), C64(0x0080040800100080),
     C64(0x0080020400080080), C64(0x0080010200040080), C64(0x0080008001000200), C64(0x0080002040800100),
     C64(0x0000800020400080), C64(0x0000400020005000), C64(0x0000801000200080), C64(0x0000800800100080),
@@ -59,7 +59,7 @@ const U64 magicmoves_r_magics[64] = {
     C64(0x00FFFCDDFCED714A), C64(0x007FFCDDFCED714A), C64(0x003FFFCDFFD88096), C64(0x0000040810002101),
     C64(0x0001000204080011), C64(0x0001000204000801), C64(0x0001000082000401), C64(0x0001FFFAABFAD1A2)
 };
-const U64 magicmoves_r_mask[64] = {
+constexpr U64 magicmoves_r_mask[64] = {
     C64(0x000101010101017E), C64(0x000202020202027C), C64(0x000404040404047A), C64(0x0008080808080876),
     C64(0x001010101010106E), C64(0x002020202020205E), C64(0x004040404040403E), C64(0x008080808080807E),
     C64(0x0001010101017E00), C64(0x0002020202027C00), C64(0x0004040404047A00), C64(0x0008080808087600),
@@ -78,7 +78,7 @@ const U64 magicmoves_r_mask[64] = {
     C64(0x6E10101010101000), C64(0x5E20202020202000), C64(0x3E40404040404000), C64(0x7E80808080808000)
 };
 
-const unsigned int magicmoves_b_shift[64] = {
+constexpr unsigned int magicmoves_b_shift[64] = {
     58, 59, 59, 59, 59, 59, 59, 58,
     59, 59, 59, 59, 59, 59, 59, 59,
     59, 59, 57, 57, 57, 57, 59, 59,
@@ -89,7 +89,7 @@ const unsigned int magicmoves_b_shift[64] = {
     58, 59, 59, 59, 59, 59, 59, 58
 };
 
-const U64 magicmoves_b_magics[64] = {
+constexpr U64 magicmoves_b_magics[64] = {
     C64(0x0002020202020200), C64(0x0002020202020000), C64(0x0004010202000000), C64(0x0004040080000000),
     C64(0x0001104000000000), C64(0x0000821040000000), C64(0x0000410410400000), C64(0x0000104104104000),
     C64(0x0000040404040400), C64(0x0000020202020200), C64(0x0000040102020000), C64(0x0000040400800000),
@@ -108,7 +108,7 @@ const U64 magicmoves_b_magics[64] = {
     C64(0x0000000010020200), C64(0x0000000404080200), C64(0x0000040404040400), C64(0x0002020202020200)
 };
 
-const U64 magicmoves_b_mask[64] = {
+constexpr U64 magicmoves_b_mask[64] = {
     C64(0x0040201008040200), C64(0x0000402010080400), C64(0x0000004020100A00), C64(0x0000000040221400),
     C64(0x0000000002442800), C64(0x0000000204085000), C64(0x0000020408102000), C64(0x0002040810204000),
     C64(0x0020100804020000), C64(0x0040201008040000), C64(0x00004020100A0000), C64(0x0000004022140000),
@@ -127,57 +127,9 @@ const U64 magicmoves_b_mask[64] = {
     C64(0x0028440200000000), C64(0x0050080402000000), C64(0x0020100804020000), C64(0x0040201008040200)
 };
 
-U64 magicmovesbdb[5248];
-const U64 *magicmoves_b_indices[64] = {
-    magicmovesbdb + 4992, magicmovesbdb + 2624,  magicmovesbdb + 256,  magicmovesbdb + 896,
-    magicmovesbdb + 1280, magicmovesbdb + 1664, magicmovesbdb + 4800, magicmovesbdb + 5120,
-    magicmovesbdb + 2560, magicmovesbdb + 2656,  magicmovesbdb + 288,  magicmovesbdb + 928,
-    magicmovesbdb + 1312, magicmovesbdb + 1696, magicmovesbdb + 4832, magicmovesbdb + 4928,
-    magicmovesbdb + 0,     magicmovesbdb + 128,  magicmovesbdb + 320,  magicmovesbdb + 960,
-    magicmovesbdb + 1344, magicmovesbdb + 1728, magicmovesbdb + 2304, magicmovesbdb + 2432,
-    magicmovesbdb + 32,    magicmovesbdb + 160,  magicmovesbdb + 448, magicmovesbdb + 2752,
-    magicmovesbdb + 3776, magicmovesbdb + 1856, magicmovesbdb + 2336, magicmovesbdb + 2464,
-    magicmovesbdb + 64,    magicmovesbdb + 192,  magicmovesbdb + 576, magicmovesbdb + 3264,
-    magicmovesbdb + 4288, magicmovesbdb + 1984, magicmovesbdb + 2368, magicmovesbdb + 2496,
-    magicmovesbdb + 96,    magicmovesbdb + 224,  magicmovesbdb + 704, magicmovesbdb + 1088,
-    magicmovesbdb + 1472, magicmovesbdb + 2112, magicmovesbdb + 2400, magicmovesbdb + 2528,
-    magicmovesbdb + 2592, magicmovesbdb + 2688,  magicmovesbdb + 832, magicmovesbdb + 1216,
-    magicmovesbdb + 1600, magicmovesbdb + 2240, magicmovesbdb + 4864, magicmovesbdb + 4960,
-    magicmovesbdb + 5056, magicmovesbdb + 2720,  magicmovesbdb + 864, magicmovesbdb + 1248,
-    magicmovesbdb + 1632, magicmovesbdb + 2272, magicmovesbdb + 4896, magicmovesbdb + 5184
-};
-
-U64 magicmovesrdb[102400];
-const U64 *magicmoves_r_indices[64] = {
-    magicmovesrdb + 86016, magicmovesrdb + 73728, magicmovesrdb + 36864, magicmovesrdb + 43008,
-    magicmovesrdb + 47104, magicmovesrdb + 51200, magicmovesrdb + 77824, magicmovesrdb + 94208,
-    magicmovesrdb + 69632, magicmovesrdb + 32768, magicmovesrdb + 38912, magicmovesrdb + 10240,
-    magicmovesrdb + 14336, magicmovesrdb + 53248, magicmovesrdb + 57344, magicmovesrdb + 81920,
-    magicmovesrdb + 24576, magicmovesrdb + 33792,  magicmovesrdb + 6144, magicmovesrdb + 11264,
-    magicmovesrdb + 15360, magicmovesrdb + 18432, magicmovesrdb + 58368, magicmovesrdb + 61440,
-    magicmovesrdb + 26624,  magicmovesrdb + 4096,  magicmovesrdb + 7168,     magicmovesrdb + 0,
-    magicmovesrdb + 2048, magicmovesrdb + 19456, magicmovesrdb + 22528, magicmovesrdb + 63488,
-    magicmovesrdb + 28672,  magicmovesrdb + 5120,  magicmovesrdb + 8192,  magicmovesrdb + 1024,
-    magicmovesrdb + 3072, magicmovesrdb + 20480, magicmovesrdb + 23552, magicmovesrdb + 65536,
-    magicmovesrdb + 30720, magicmovesrdb + 34816,  magicmovesrdb + 9216, magicmovesrdb + 12288,
-    magicmovesrdb + 16384, magicmovesrdb + 21504, magicmovesrdb + 59392, magicmovesrdb + 67584,
-    magicmovesrdb + 71680, magicmovesrdb + 35840, magicmovesrdb + 39936, magicmovesrdb + 13312,
-    magicmovesrdb + 17408, magicmovesrdb + 54272, magicmovesrdb + 60416, magicmovesrdb + 83968,
-    magicmovesrdb + 90112, magicmovesrdb + 75776, magicmovesrdb + 40960, magicmovesrdb + 45056,
-    magicmovesrdb + 49152, magicmovesrdb + 55296, magicmovesrdb + 79872, magicmovesrdb + 98304
-};
-
-U64 initmagicmoves_occ(const int *squares, const int numSquares, const U64 linocc) {
-    int i;
-    U64 ret = 0;
-    for (i = 0; i < numSquares; i++)
-        if (linocc & (((U64)(1)) << i)) ret |= (((U64)(1)) << squares[i]);
-    return ret;
-}
-
-U64 initmagicmoves_Rmoves(const int square, const U64 occ) {
+constexpr U64 initmagicmoves_Rmoves(const int square, const U64 occ) {
     U64 ret = 0;
-    U64 bit;
+    U64 bit = 0;
     U64 rowbits = (((U64)0xFF) << (8 * (square / 8)));
 
     bit = (((U64)(1)) << square);
@@ -205,10 +157,10 @@ U64 initmagicmoves_Rmoves(const int square, const U64 occ) {
     return ret;
 }
 
-U64 initmagicmoves_Bmoves(const int square, const U64 occ) {
+constexpr U64 initmagicmoves_Bmoves(const int square, const U64 occ) {
     U64 ret = 0;
-    U64 bit;
-    U64 bit2;
+    U64 bit = 0;
+    U64 bit2 = 0;
     U64 rowbits = (((U64)0xFF) << (8 * (square / 8)));
 
     bit = (((U64)(1)) << square);
@@ -246,93 +198,55 @@ U64 initmagicmoves_Bmoves(const int square, const U64 occ) {
     return ret;
 }
 
-//used so that the original indices can be left as const so that the compiler can optimize better
+// Rodent: the move databases are generated at compile time instead of by initmagicmoves().
+// Each square has its own table, so that every constant evaluation stays small enough for
+// default compiler limits.
 
-#define BmagicNOMASK2(square, occupancy) *(magicmoves_b_indices2[square]+(((occupancy)*magicmoves_b_magics[square])>>magicmoves_b_shift[square]))
-#define RmagicNOMASK2(square, occupancy) *(magicmoves_r_indices2[square]+(((occupancy)*magicmoves_r_magics[square])>>magicmoves_r_shift[square]))
+template<int size> struct magicmoves_db {
+    U64 entry[size];
+};
+
+template<int square, bool bishop> constexpr int magicmoves_size() {
+    return 1 << (64 - (bishop ? magicmoves_b_shift[square] : magicmoves_r_shift[square]));
+}
 
-void initmagicmoves() {
-    int i;
+template<int square, bool bishop> constexpr magicmoves_db<magicmoves_size<square, bishop>()> initmagicmoves_db() {
 
-    //for bitscans :
-    //initmagicmoves_bitpos64_database[(x*C64(0x07EDD5E59A4E28C2))>>58]
-    int initmagicmoves_bitpos64_database[64] = {
-        63,  0, 58,  1, 59, 47, 53,  2,
-        60, 39, 48, 27, 54, 33, 42,  3,
-        61, 51, 37, 40, 49, 18, 28, 20,
-        55, 30, 34, 11, 43, 14, 22,  4,
-        62, 57, 46, 52, 38, 26, 32, 41,
-        50, 36, 17, 19, 29, 10, 13, 21,
-        56, 45, 25, 31, 35, 16,  9, 12,
-        44, 24, 15,  8, 23,  7,  6,  5
-    };
+    magicmoves_db<magicmoves_size<square, bishop>()> db = {};
+    const U64 mask = bishop ? magicmoves_b_mask[square] : magicmoves_r_mask[square];
+    U64 occ = 0;
 
-    //identical to magicmove_x_indices except without the const modifier
-    U64 *magicmoves_b_indices2[64] = {
-        magicmovesbdb + 4992, magicmovesbdb + 2624,  magicmovesbdb + 256,  magicmovesbdb + 896,
-        magicmovesbdb + 1280, magicmovesbdb + 1664, magicmovesbdb + 4800, magicmovesbdb + 5120,
-        magicmovesbdb + 2560, magicmovesbdb + 2656,  magicmovesbdb + 288,  magicmovesbdb + 928,
-        magicmovesbdb + 1312, magicmovesbdb + 1696, magicmovesbdb + 4832, magicmovesbdb + 4928,
-        magicmovesbdb + 0,     magicmovesbdb + 128,  magicmovesbdb + 320,  magicmovesbdb + 960,
-        magicmovesbdb + 1344, magicmovesbdb + 1728, magicmovesbdb + 2304, magicmovesbdb + 2432,
-        magicmovesbdb + 32,    magicmovesbdb + 160,  magicmovesbdb + 448, magicmovesbdb + 2752,
-        magicmovesbdb + 3776, magicmovesbdb + 1856, magicmovesbdb + 2336, magicmovesbdb + 2464,
-        magicmovesbdb + 64,    magicmovesbdb + 192,  magicmovesbdb + 576, magicmovesbdb + 3264,
-        magicmovesbdb + 4288, magicmovesbdb + 1984, magicmovesbdb + 2368, magicmovesbdb + 2496,
-        magicmovesbdb + 96,    magicmovesbdb + 224,  magicmovesbdb + 704, magicmovesbdb + 1088,
-        magicmovesbdb + 1472, magicmovesbdb + 2112, magicmovesbdb + 2400, magicmovesbdb + 2528,
-        magicmovesbdb + 2592, magicmovesbdb + 2688,  magicmovesbdb + 832, magicmovesbdb + 1216,
-        magicmovesbdb + 1600, magicmovesbdb + 2240, magicmovesbdb + 4864, magicmovesbdb + 4960,
-        magicmovesbdb + 5056, magicmovesbdb + 2720,  magicmovesbdb + 864, magicmovesbdb + 1248,
-        magicmovesbdb + 1632, magicmovesbdb + 2272, magicmovesbdb + 4896, magicmovesbdb + 5184
-    };
-    U64 *magicmoves_r_indices2[64] = {
-        magicmovesrdb + 86016, magicmovesrdb + 73728, magicmovesrdb + 36864, magicmovesrdb + 43008,
-        magicmovesrdb + 47104, magicmovesrdb + 51200, magicmovesrdb + 77824, magicmovesrdb + 94208,
-        magicmovesrdb + 69632, magicmovesrdb + 32768, magicmovesrdb + 38912, magicmovesrdb + 10240,
-        magicmovesrdb + 14336, magicmovesrdb + 53248, magicmovesrdb + 57344, magicmovesrdb + 81920,
-        magicmovesrdb + 24576, magicmovesrdb + 33792,  magicmovesrdb + 6144, magicmovesrdb + 11264,
-        magicmovesrdb + 15360, magicmovesrdb + 18432, magicmovesrdb + 58368, magicmovesrdb + 61440,
-        magicmovesrdb + 26624,  magicmovesrdb + 4096,  magicmovesrdb + 7168,     magicmovesrdb + 0,
-        magicmovesrdb + 2048,  magicmovesrdb + 19456, magicmovesrdb + 22528, magicmovesrdb + 63488,
-        magicmovesrdb + 28672,  magicmovesrdb + 5120,  magicmovesrdb + 8192,  magicmovesrdb + 1024,
-        magicmovesrdb + 3072,  magicmovesrdb + 20480, magicmovesrdb + 23552, magicmovesrdb + 65536,
-        magicmovesrdb + 30720, magicmovesrdb + 34816,  magicmovesrdb + 9216, magicmovesrdb + 12288,
-        magicmovesrdb + 16384, magicmovesrdb + 21504, magicmovesrdb + 59392, magicmovesrdb + 67584,
-        magicmovesrdb + 71680, magicmovesrdb + 35840, magicmovesrdb + 39936, magicmovesrdb + 13312,
-        magicmovesrdb + 17408, magicmovesrdb + 54272, magicmovesrdb + 60416, magicmovesrdb + 83968,
-        magicmovesrdb + 90112, magicmovesrdb + 75776, magicmovesrdb + 40960, magicmovesrdb + 45056,
-        magicmovesrdb + 49152, magicmovesrdb + 55296, magicmovesrdb + 79872, magicmovesrdb + 98304
-    };
+    do {    // all subsets of the mask (carry-rippler)
+        if (bishop)
+            db.entry[(occ * magicmoves_b_magics[square]) >> magicmoves_b_shift[square]] = initmagicmoves_Bmoves(square, occ);
+        else
+            db.entry[(occ * magicmoves_r_magics[square]) >> magicmoves_r_shift[square]] = initmagicmoves_Rmoves(square, occ);
+        occ = (occ - mask) & mask;
+    } while (occ);
 
-    for (i = 0; i < 64; i++) {
-        int squares[64];
-        int numsquares = 0;
-        U64 temp = magicmoves_b_mask[i];
-        while (temp) {
-            #pragma warning( suppress : 4146 )
-            U64 bit = temp & -temp;
-            squares[numsquares++] = initmagicmoves_bitpos64_database[(bit * C64(0x07EDD5E59A4E28C2)) >> 58];
-            temp ^= bit;
-        }
-        for (temp = 0; temp < (((U64)(1)) << numsquares); temp++) {
-            U64 tempocc = initmagicmoves_occ(squares, numsquares, temp);
-            BmagicNOMASK2(i, tempocc) = initmagicmoves_Bmoves(i, tempocc);
-        }
-    }
-    for (i = 0; i < 64; i++) {
-        int squares[64];
-        int numsquares = 0;
-        U64 temp = magicmoves_r_mask[i];
-        while (temp) {
-            #pragma warning( suppress : 4146 )
-            U64 bit = temp & -temp;
-            squares[numsquares++] = initmagicmoves_bitpos64_database[(bit * C64(0x07EDD5E59A4E28C2)) >> 58];
-            temp ^= bit;
-        }
-        for (temp = 0; temp < (((U64)(1)) << numsquares); temp++) {
-            U64 tempocc = initmagicmoves_occ(squares, numsquares, temp);
-            RmagicNOMASK2(i, tempocc) = initmagicmoves_Rmoves(i, tempocc);
-        }
-    }
+    return db;
 }
+
+template<int square, bool bishop> constexpr auto magicmoves_sqdb = initmagicmoves_db<square, bishop>();
+
+const U64 *magicmoves_b_indices[64] = {
+    magicmoves_sqdb<0, true>.entry, magicmoves_sqdb<1, true>.entry, magicmoves_sqdb<2, true>.entry, magicmoves_sqdb<3, true>.entry, magicmoves_sqdb<4, true>.entry, magicmoves_sqdb<5, true>.entry, magicmoves_sqdb<6, true>.entry, magicmoves_sqdb<7, true>.entry,
+    magicmoves_sqdb<8, true>.entry, magicmoves_sqdb<9, true>.entry, magicmoves_sqdb<10, true>.entry, magicmoves_sqdb<11, true>.entry, magicmoves_sqdb<12, true>.entry, magicmoves_sqdb<13, true>.entry, magicmoves_sqdb<14, true>.entry, magicmoves_sqdb<15, true>.entry,
+    magicmoves_sqdb<16, true>.entry, magicmoves_sqdb<17, true>.entry, magicmoves_sqdb<18, true>.entry, magicmoves_sqdb<19, true>.entry, magicmoves_sqdb<20, true>.entry, magicmoves_sqdb<21, true>.entry, magicmoves_sqdb<22, true>.entry, magicmoves_sqdb<23, true>.entry,
+    magicmoves_sqdb<24, true>.entry, magicmoves_sqdb<25, true>.entry, magicmoves_sqdb<26, true>.entry, magicmoves_sqdb<27, true>.entry, magicmoves_sqdb<28, true>.entry, magicmoves_sqdb<29, true>.entry, magicmoves_sqdb<30, true>.entry, magicmoves_sqdb<31, true>.entry,
+    magicmoves_sqdb<32, true>.entry, magicmoves_sqdb<33, true>.entry, magicmoves_sqdb<34, true>.entry, magicmoves_sqdb<35, true>.entry, magicmoves_sqdb<36, true>.entry, magicmoves_sqdb<37, true>.entry, magicmoves_sqdb<38, true>.entry, magicmoves_sqdb<39, true>.entry,
+    magicmoves_sqdb<40, true>.entry, magicmoves_sqdb<41, true>.entry, magicmoves_sqdb<42, true>.entry, magicmoves_sqdb<43, true>.entry, magicmoves_sqdb<44, true>.entry, magicmoves_sqdb<45, true>.entry, magicmoves_sqdb<46, true>.entry, magicmoves_sqdb<47, true>.entry,
+    magicmoves_sqdb<48, true>.entry, magicmoves_sqdb<49, true>.entry, magicmoves_sqdb<50, true>.entry, magicmoves_sqdb<51, true>.entry, magicmoves_sqdb<52, true>.entry, magicmoves_sqdb<53, true>.entry, magicmoves_sqdb<54, true>.entry, magicmoves_sqdb<55, true>.entry,
+    magicmoves_sqdb<56, true>.entry, magicmoves_sqdb<57, true>.entry, magicmoves_sqdb<58, true>.entry, magicmoves_sqdb<59, true>.entry, magicmoves_sqdb<60, true>.entry, magicmoves_sqdb<61, true>.entry, magicmoves_sqdb<62, true>.entry, magicmoves_sqdb<63, true>.entry
+};
+
+const U64 *magicmoves_r_indices[64] = {
+    magicmoves_sqdb<0, false>.entry, magicmoves_sqdb<1, false>.entry, magicmoves_sqdb<2, false>.entry, magicmoves_sqdb<3, false>.entry, magicmoves_sqdb<4, false>.entry, magicmoves_sqdb<5, false>.entry, magicmoves_sqdb<6, false>.entry, magicmoves_sqdb<7, false>.entry,
+    magicmoves_sqdb<8, false>.entry, magicmoves_sqdb<9, false>.entry, magicmoves_sqdb<10, false>.entry, magicmoves_sqdb<11, false>.entry, magicmoves_sqdb<12, false>.entry, magicmoves_sqdb<13, false>.entry, magicmoves_sqdb<14, false>.entry, magicmoves_sqdb<15, false>.entry,
+    magicmoves_sqdb<16, false>.entry, magicmoves_sqdb<17, false>.entry, magicmoves_sqdb<18, false>.entry, magicmoves_sqdb<19, false>.entry, magicmoves_sqdb<20, false>.entry, magicmoves_sqdb<21, false>.entry, magicmoves_sqdb<22, false>.entry, magicmoves_sqdb<23, false>.entry,
+    magicmoves_sqdb<24, false>.entry, magicmoves_sqdb<25, false>.entry, magicmoves_sqdb<26, false>.entry, magicmoves_sqdb<27, false>.entry, magicmoves_sqdb<28, false>.entry, magicmoves_sqdb<29, false>.entry, magicmoves_sqdb<30, false>.entry, magicmoves_sqdb<31, false>.entry,
+    magicmoves_sqdb<32, false>.entry, magicmoves_sqdb<33, false>.entry, magicmoves_sqdb<34, false>.entry, magicmoves_sqdb<35, false>.entry, magicmoves_sqdb<36, false>.entry, magicmoves_sqdb<37, false>.entry, magicmoves_sqdb<38, false>.entry, magicmoves_sqdb<39, false>.entry,
+    magicmoves_sqdb<40, false>.entry, magicmoves_sqdb<41, false>.entry, magicmoves_sqdb<42, false>.entry, magicmoves_sqdb<43, false>.entry, magicmoves_sqdb<44, false>.entry, magicmoves_sqdb<45, false>.entry, magicmoves_sqdb<46, false>.entry, magicmoves_sqdb<47, false>.entry,
+    magicmoves_sqdb<48, false>.entry, magicmoves_sqdb<49, false>.entry, magicmoves_sqdb<50, false>.entry, magicmoves_sqdb<51, false>.entry, magicmoves_sqdb<52, false>.entry, magicmoves_sqdb<53, false>.entry, magicmoves_sqdb<54, false>.entry, magicmoves_sqdb<55, false>.entry,
+    magicmoves_sqdb<56, false>.entry, magicmoves_sqdb<57, false>.entry, magicmoves_sqdb<58, false>.entry, magicmoves_sqdb<59, false>.entry, magicmoves_sqdb<60, false>.entry, magicmoves_sqdb<61, false>.entry, magicmoves_sqdb<62, false>.entry, magicmoves_sqdb<63, false>.entry
+};
@@ -5,8 +5,8 @@
  *need this functionality.
  *
  *Usage:
- *You must first initialize the generator with a call to initmagicmoves().
- *Then you can use the following macros for generating move bitboards by
+ *(Rodent: the move databases are generated at compile time, no initialization needed.)
+ *You can use the following macros for generating move bitboards by
  *giving them a square and an occupancy.  The macro will then "return"
  *the correct move bitboard for that particular square and occupancy. It
  *has been named Rmagic and Bmagic so that it will not conflict with
@@ -110,4 +110,3 @@ extern const U64 *magicmoves_r_indices[64];
 
 #endif //USE_INLINING
 
-void initmagicmoves();
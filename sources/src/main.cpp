@@ -27,6 +27,7 @@ cGlobals Glob;
 #else
     cEngine EngineSingle(0);
 #endif
+cCpu Cpu;
 cBitBoard BB;
 cParam Par;
 cMask Mask;
@@ -69,11 +70,25 @@ void PrintVersion() {
 #elif defined(__GNUC__) && defined(__SSSE3__) // we are using custom SSSE3 popcount implementation
             "/SSSE3"
 #endif
+    );
 
-                        "\n");
+#ifdef USE_CPU_DISPATCH
+    if (Cpu.use_popcnt) printf("/POPCNT"); // only popcount is dispatched on the cpu level
+#endif
+#ifdef USE_PEXT
+    if (Cpu.use_pext) printf("/PEXT");
+#endif
+
+    printf("\n");
+
+#ifdef USE_CPU_DISPATCH
+    if (Glob.is_noisy && Cpu.level != Cpu.detected)
+        printf("info string cpu supports %s, using %s (RIIICPU)\n", Cpu.Name(Cpu.detected), Cpu.Name(Cpu.level));
+#endif
 }
 
-int main() {
+int main(int argc, char *argv[]) {
+    SaveStartDir();
 	Glob.threadOverride = 0;
 	ReadThreadNumber("threads.ini");
 
@@ -83,8 +98,8 @@ int main() {
 #endif
 
     srand(GetMS());
+    Cpu.Init();
     BB.Init();
-    cEngine::InitSearch();
     POS::Init();
     Glob.Init();
     Par.DefaultWeights();
@@ -122,7 +137,9 @@ if (Glob.is_noisy) {
 
     InternalBook.Init();
 
-#ifndef BOOKGEN
+#if defined(MICROBENCH)
+    MicroBench(argc > 1 ? atoi(argv[1]) : 0);
+#elif !defined(BOOKGEN)
     UciLoop();
 #endif
 }
@@ -132,6 +149,7 @@ void cGlobals::Init() {
 	is_noisy = false;
     is_testing = false;
     is_tuning = false;
+    is_bench = false;
     reading_personality = false;
     use_personality_files = true;
     use_books_from_pers = true;
@@ -140,6 +158,8 @@ void cGlobals::Init() {
 	if (Glob.threadOverride)
 		thread_no = Glob.threadOverride;
 	time_buffer = 10; // blitz under Arena would require something like 200, but it's user's job
+    eval_hash_kb = EVAL_HASH_KB;
+    pawn_hash_kb = PAWN_HASH_KB;
 	time_tricks = false;
 	game_key = 0;
 
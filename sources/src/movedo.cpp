@@ -39,7 +39,7 @@ void POS::DoMove(int move, UNDO *u) {
 
     // Update reversible moves counter
 
-    mRepList[mHead++] = mHashKey;
+    mRepList[mHead++ & (REP_LIST_SIZE - 1)] = mHashKey;
     if (ftp == P || ttp != NO_TP) mRevMoves = 0;
     else                          mRevMoves++;
 
@@ -68,8 +68,7 @@ void POS::DoMove(int move, UNDO *u) {
     mHashKey ^= msZobPiece[Pc(sd, ftp)][fsq] ^ msZobPiece[Pc(sd, ftp)][tsq];
     mClBb[sd] ^= SqBb(fsq) | SqBb(tsq);
     mTpBb[ftp] ^= SqBb(fsq) | SqBb(tsq);
-    mMgSc[sd] += Par.mg_pst[sd][ftp][tsq] - Par.mg_pst[sd][ftp][fsq];
-    mEgSc[sd] += Par.eg_pst[sd][ftp][tsq] - Par.eg_pst[sd][ftp][fsq];
+    mPstSc[sd] += Par.pst[sd][ftp][tsq] - Par.pst[sd][ftp][fsq];
 
     // Update king location
 
@@ -86,10 +85,10 @@ void POS::DoMove(int move, UNDO *u) {
 
         mClBb[op] ^= SqBb(tsq);
         mTpBb[ttp] ^= SqBb(tsq);
-        mMgSc[op] -= Par.mg_pst[op][ttp][tsq];
-        mEgSc[op] -= Par.eg_pst[op][ttp][tsq];
+        mPstSc[op] -= Par.pst[op][ttp][tsq];
         mPhase -= ph_value[ttp];
         mCnt[op][ttp]--; // piece count
+        mMaterialKey -= MatKey(op, ttp);
     }
 
     switch (MoveType(move)) {
@@ -114,8 +113,7 @@ void POS::DoMove(int move, UNDO *u) {
             mHashKey ^= msZobPiece[Pc(sd, R)][fsq] ^ msZobPiece[Pc(sd, R)][tsq];
             mClBb[sd] ^= SqBb(fsq) | SqBb(tsq);
             mTpBb[R] ^= SqBb(fsq) | SqBb(tsq);
-            mMgSc[sd] += Par.mg_pst[sd][R][tsq] - Par.mg_pst[sd][R][fsq];
-            mEgSc[sd] += Par.eg_pst[sd][R][tsq] - Par.eg_pst[sd][R][fsq];
+            mPstSc[sd] += Par.pst[sd][R][tsq] - Par.pst[sd][R][fsq];
             break;
 
         // En passant capture
@@ -127,10 +125,10 @@ void POS::DoMove(int move, UNDO *u) {
             mPawnKey ^= msZobPiece[Pc(op, P)][tsq];
             mClBb[op] ^= SqBb(tsq);
             mTpBb[P] ^= SqBb(tsq);
-            mMgSc[op] -= Par.mg_pst[op][P][tsq];
-            mEgSc[op] -= Par.eg_pst[op][P][tsq];
+            mPstSc[op] -= Par.pst[op][P][tsq];
             mPhase -= ph_value[P];
             mCnt[op][P]--;
+            mMaterialKey -= MatKey(op, P);
             break;
 
         // Double pawn move
@@ -152,11 +150,11 @@ void POS::DoMove(int move, UNDO *u) {
             mPawnKey ^= msZobPiece[Pc(sd, P)][tsq];
             mTpBb[P] ^= SqBb(tsq);
             mTpBb[ftp] ^= SqBb(tsq);
-            mMgSc[sd] += Par.mg_pst[sd][ftp][tsq] - Par.mg_pst[sd][P][tsq];
-            mEgSc[sd] += Par.eg_pst[sd][ftp][tsq] - Par.eg_pst[sd][P][tsq];
+            mPstSc[sd] += Par.pst[sd][ftp][tsq] - Par.pst[sd][P][tsq];
             mPhase += ph_value[ftp] - ph_value[P];
             mCnt[sd][P]--;
             mCnt[sd][ftp]++;
+            mMaterialKey += MatKey(sd, ftp) - MatKey(sd, P);
             break;
     }
 
@@ -170,7 +168,7 @@ void POS::DoNull(UNDO *u) {
 
     u->mEpSqUd    = mEpSq;
     u->mHashKeyUd = mHashKey;
-    mRepList[mHead++] = mHashKey;
+    mRepList[mHead++ & (REP_LIST_SIZE - 1)] = mHashKey;
     mRevMoves++;
     if (mEpSq != NO_SQ) {
         mHashKey ^= msZobEp[File(mEpSq)];
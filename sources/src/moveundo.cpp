@@ -38,8 +38,7 @@ void POS::UndoMove(int move, UNDO *u) {
     mPc[tsq] = NO_PC;
     mClBb[sd] ^= SqBb(fsq) | SqBb(tsq);
     mTpBb[ftp] ^= SqBb(fsq) | SqBb(tsq);
-    mMgSc[sd] += Par.mg_pst[sd][ftp][fsq] - Par.mg_pst[sd][ftp][tsq];
-    mEgSc[sd] += Par.eg_pst[sd][ftp][fsq] - Par.eg_pst[sd][ftp][tsq];
+    mPstSc[sd] += Par.pst[sd][ftp][fsq] - Par.pst[sd][ftp][tsq];
 
     // Change king location
 
@@ -51,10 +50,10 @@ void POS::UndoMove(int move, UNDO *u) {
         mPc[tsq] = Pc(op, ttp);
         mClBb[op] ^= SqBb(tsq);
         mTpBb[ttp] ^= SqBb(tsq);
-        mMgSc[op] += Par.mg_pst[op][ttp][tsq];
-        mEgSc[op] += Par.eg_pst[op][ttp][tsq];
+        mPstSc[op] += Par.pst[op][ttp][tsq];
         mPhase += ph_value[ttp];
         mCnt[op][ttp]++;
+        mMaterialKey += MatKey(op, ttp);
     }
 
     switch (MoveType(move)) {
@@ -77,8 +76,7 @@ void POS::UndoMove(int move, UNDO *u) {
             mPc[fsq] = Pc(sd, R);
             mClBb[sd] ^= SqBb(fsq) | SqBb(tsq);
             mTpBb[R] ^= SqBb(fsq) | SqBb(tsq);
-            mMgSc[sd] += Par.mg_pst[sd][R][fsq] - Par.mg_pst[sd][R][tsq];
-            mEgSc[sd] += Par.eg_pst[sd][R][fsq] - Par.eg_pst[sd][R][tsq];
+            mPstSc[sd] += Par.pst[sd][R][fsq] - Par.pst[sd][R][tsq];
             break;
 
         case EP_CAP:
@@ -86,10 +84,10 @@ void POS::UndoMove(int move, UNDO *u) {
             mPc[tsq] = Pc(op, P);
             mClBb[op] ^= SqBb(tsq);
             mTpBb[P] ^= SqBb(tsq);
-            mMgSc[op] += Par.mg_pst[op][P][tsq];
-            mEgSc[op] += Par.eg_pst[op][P][tsq];
+            mPstSc[op] += Par.pst[op][P][tsq];
             mPhase += ph_value[P];
             mCnt[op][P]++;
+            mMaterialKey += MatKey(op, P);
             break;
 
         case EP_SET:
@@ -99,11 +97,11 @@ void POS::UndoMove(int move, UNDO *u) {
             mPc[fsq] = Pc(sd, P);
             mTpBb[P] ^= SqBb(fsq);
             mTpBb[ftp] ^= SqBb(fsq);
-            mMgSc[sd] += Par.mg_pst[sd][P][fsq] - Par.mg_pst[sd][ftp][fsq];
-            mEgSc[sd] += Par.eg_pst[sd][P][fsq] - Par.eg_pst[sd][ftp][fsq];
+            mPstSc[sd] += Par.pst[sd][P][fsq] - Par.pst[sd][ftp][fsq];
             mPhase += ph_value[P] - ph_value[ftp];
             mCnt[sd][P]++;
             mCnt[sd][ftp]--;
+            mMaterialKey += MatKey(sd, P) - MatKey(sd, ftp);
             break;
     }
 
@@ -209,9 +209,10 @@ int cEngine::NextSpecialMove(MOVES *m, int *flag) {
     return 0;
 }
 
-void cEngine::InitCaptures(POS *p, MOVES *m) {
+void cEngine::InitCaptures(POS *p, MOVES *m, int trans_move) {
 
     m->p = p;
+    m->trans_move = trans_move;
     m->last = m->p->GenerateCaptures(m->move);
     ScoreCaptures(m);
     m->next = m->move;
@@ -229,8 +230,10 @@ void cEngine::ScoreCaptures(MOVES *m) {
     int *movep, *valuep;
 
     valuep = m->value;
-    for (movep = m->move; movep < m->last; movep++)
-        *valuep++ = MvvLva(m->p, *movep);
+    for (movep = m->move; movep < m->last; movep++) {
+        if (*movep == m->trans_move) *valuep++ = INF; // hash move goes first
+        else                         *valuep++ = MvvLva(m->p, *movep);
+    }
 }
 
 void cEngine::ScoreQuiet(MOVES *m, int ply) {
@@ -268,18 +271,9 @@ int cEngine::SelectBest(MOVES *m) {
 
 int cEngine::BadCapture(POS *p, int move) {
 
-    int fsq = Fsq(move);
-    int tsq = Tsq(move);
-
     // all minor piece exchanges are tried, because tp_value[B] == tp_value[N]
 
-    if (tp_value[p->TpOnSq(tsq)] >= tp_value[p->TpOnSq(fsq)])
-        return 0;
-
-    if (MoveType(move) == EP_CAP)
-        return 0;
-
-    return p->Swap(fsq, tsq) < 0;
+    return !p->SeeGE(move, 0);
 }
 
 int cEngine::MvvLva(POS *p, int move) {
@@ -1043,6 +1043,9 @@ void cParam::InitBackward() {
 
 void cParam::InitPst() {
 
+    int mg_pst[2][6][64];
+    int eg_pst[2][6][64];
+
     for (int sq = 0; sq < 64; sq++) {
         for (eColor sd = WC; sd < 2; ++sd) {
 
@@ -1574,30 +1577,42 @@ void cParam::InitPst() {
 	mg_pst[BC][B][G1] = ((values[B_MID] * Par.values[W_MATERIAL]) / 100) + values[g8Bish];
 	mg_pst[WC][B][H8] = ((values[B_MID] * Par.values[W_MATERIAL]) / 100) + values[h8Bish];
 	mg_pst[BC][B][H1] = ((values[B_MID] * Par.values[W_MATERIAL]) / 100) + values[h8Bish];
+
+    // Piece values go to the material hash (sMaterialEntry::piece_value) instead,
+    // so that the packed piece/square scores stay small
+
+    const int mid[6] = { P_MID, N_MID, B_MID, R_MID, Q_MID, 0 };
+    const int end[6] = { P_END, N_END, B_END, R_END, Q_END, 0 };
+
+    for (int pc = 0; pc < 6; pc++) {
+        mat_mg[pc] = pc == K ? 0 : (values[mid[pc]] * Par.values[W_MATERIAL]) / 100;
+        mat_eg[pc] = pc == K ? 0 : (values[end[pc]] * Par.values[W_MATERIAL]) / 100;
+    }
+
+    for (eColor sd = WC; sd < 2; ++sd)
+        for (int pc = 0; pc < 6; pc++)
+            for (int sq = 0; sq < 64; sq++)
+                pst[sd][pc][sq] = S(mg_pst[sd][pc][sq] - mat_mg[pc], eg_pst[sd][pc][sq] - mat_eg[pc]);
 }
 
 void cParam::InitMobility() {
 
     for (int i = 0; i < 9; i++) {
-        n_mob_mg[i] = Par.mob_style == 0 ? 4 * (i - 4) : values[NMG0+i]; 
-        n_mob_eg[i] = Par.mob_style == 0 ? 4 * (i - 4) : values[NEG0+i];
+        n_mob[i] = Par.mob_style == 0 ? S(4 * (i - 4), 4 * (i - 4)) : S(values[NMG0+i], values[NEG0+i]);
     }
 
     for (int i = 0; i < 14; i++) {
-        b_mob_mg[i] = Par.mob_style == 0 ? 5 * (i - 6) : values[BMG0+i];
-        b_mob_eg[i] = Par.mob_style == 0 ? 5 * (i - 6) : values[BEG0+i];
+        b_mob[i] = Par.mob_style == 0 ? S(5 * (i - 6), 5 * (i - 6)) : S(values[BMG0+i], values[BEG0+i]);
     }
 
     for (int i = 0; i < 15; i++) {
-        r_mob_mg[i] = Par.mob_style == 0 ? 2 * (i - 7) : values[RMG0+i];
-        r_mob_eg[i] = Par.mob_style == 0 ? 4 * (i - 7) : values[REG0+i];
+        r_mob[i] = Par.mob_style == 0 ? S(2 * (i - 7), 4 * (i - 7)) : S(values[RMG0+i], values[REG0+i]);
     }
 
     // one day queen mobility will be Texel-tuned too
 
     for (int i = 0; i < 28; i++) {
-        q_mob_mg[i] = Par.mob_style == 0 ? 1 * (i - 14) : values[QMG0 + i]; //-V583 get rid of PVS Studio warning
-        q_mob_eg[i] = Par.mob_style == 0 ? 2 * (i - 14) : values[QEG0 + i];
+        q_mob[i] = Par.mob_style == 0 ? S(1 * (i - 14), 2 * (i - 14)) : S(values[QMG0 + i], values[QEG0 + i]); //-V583 get rid of PVS Studio warning
     }
 
 }
@@ -1637,6 +1652,43 @@ void cParam::InitMaterialTweaks() {
     }
 }
 
+void cParam::InitSkippedTerms() {
+
+    // Find eval terms that are multiplied by zero, so that Evaluate()
+    // does not compute them. Depends on sd_att[] and sd_mob[], so it is
+    // called from InitAsymmetric() once the side to move is known.
+
+    int skip = 0;
+
+    if (values[W_TROPISM] == 0) skip |= ET_TROPISM;
+    if (values[W_LINES] == 0) skip |= ET_LINES;
+    if (values[W_FWD] == 0) skip |= ET_FWD;
+    if (values[W_OUTPOSTS] == 0) skip |= ET_OUTPOSTS;
+    if (values[W_CENTER] == 0) skip |= ET_CENTER;
+    if (values[W_PASSERS] == 0) skip |= ET_PASSERS;
+    if (values[W_THREATS] == 0) skip |= ET_THREATS;
+
+    if (values[N_TRAP] == 0) skip |= ET_KNIGHT_PAT;
+
+    if (values[B_TRAP_A2] == 0 && values[B_TRAP_A3] == 0
+    &&  values[B_BLOCK] == 0 && values[B_RETURN] == 0
+    &&  values[B_BF_MG] == 0 && values[B_BF_EG] == 0
+    &&  values[B_FIANCH] == 0 && values[B_BADF] == 0
+    &&  values[B_KING] == 0) skip |= ET_BISHOP_PAT;
+
+    if (values[K_NO_LUFT_MG] == 0 && values[K_NO_LUFT_EG] == 0
+    &&  values[R_BLOCK_MG] == 0 && values[R_BLOCK_EG] == 0
+    &&  values[K_CASTLE_KS] == 0 && values[K_CASTLE_QS] == 0) skip |= ET_KING_PAT;
+
+    if (values[B_WING] == 0 && values[N_BLOCK] == 0) skip |= ET_CENTRAL_PAT;
+
+    for (eColor sd = WC; sd < 2; ++sd) {
+        skip_terms[sd] = skip;
+        if (sd_mob[sd] == 0) skip_terms[sd] |= ET_MOBILITY;
+        if (sd_att[sd] == 0) skip_terms[sd] |= ET_KING_ATT;
+    }
+}
+
 void cParam::InitTables() {
 
     // Init king attack table
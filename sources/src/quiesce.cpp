@@ -80,6 +80,7 @@ int cEngine::QuiesceChecks(POS *p, int ply, int alpha, int beta, int *pv) {
         // MAKE MOVE
 
         p->DoMove(move, u);
+        PrefetchEntries(p);
         if (p->Illegal()) { p->UndoMove(move, u); continue; }
 
         score = -Quiesce(p, ply + 1, -beta, -alpha, new_pv);
@@ -168,6 +169,7 @@ int cEngine::QuiesceFlee(POS *p, int ply, int alpha, int beta, int *pv) {
         // MAKE MOVE
 
         p->DoMove(move, u);
+        PrefetchEntries(p);
         if (p->Illegal()) { p->UndoMove(move, u); continue; }
 
         score = -Quiesce(p, ply + 1, -beta, -alpha, new_pv);
@@ -212,6 +214,10 @@ int cEngine::QuiesceFlee(POS *p, int ply, int alpha, int beta, int *pv) {
 int cEngine::Quiesce(POS *p, int ply, int alpha, int beta, int *pv) {
 
     int best, score, move, new_pv[MAX_PLY];
+#ifdef USE_QS_HASH
+    int hashFlag;
+    bool is_pv = (alpha != beta - 1);
+#endif
     eColor op = ~p->mSide;
     MOVES m[1];
     UNDO u[1];
@@ -229,6 +235,15 @@ int cEngine::Quiesce(POS *p, int ply, int alpha, int beta, int *pv) {
     if (Glob.abort_search && mRootDepth > 1) return 0;
     *pv = 0;
     if (p->IsDraw()) return p->DrawScore();
+    move = 0;
+
+    // RETRIEVE MOVE FROM TRANSPOSITION TABLE
+
+#ifdef USE_QS_HASH
+    if (Trans.Retrieve(p->mHashKey, &move, &score, &hashFlag, alpha, beta, QS_DEPTH, ply)) {
+        if (!is_pv) return score;
+    }
+#endif
 
     // SAFEGUARD AGAINST HITTIMG MAX PLY LIMIT
 
@@ -240,9 +255,9 @@ int cEngine::Quiesce(POS *p, int ply, int alpha, int beta, int *pv) {
         return eval;
     }
 
-    // GET STAND PAT SCORE
+    // GET STAND PAT SCORE (LAZY IF FAR OUTSIDE THE WINDOW)
 
-    best = Evaluate(p, &e);
+    best = Evaluate(p, &e, alpha, beta);
 #ifdef USE_RISKY_PARAMETER
     best = EvalScaleByDepth(p, ply, best);
 #endif
@@ -272,7 +287,7 @@ int cEngine::Quiesce(POS *p, int ply, int alpha, int beta, int *pv) {
     if (best >= beta) return best;
     if (best > alpha) alpha = best;
 
-    InitCaptures(p, m);
+    InitCaptures(p, m, move);
 
     // MAIN LOOP
 
@@ -293,6 +308,7 @@ int cEngine::Quiesce(POS *p, int ply, int alpha, int beta, int *pv) {
         }
 
         p->DoMove(move, u);
+        PrefetchEntries(p);
         if (p->Illegal()) { p->UndoMove(move, u); continue; }
         score = -Quiesce(p, ply + 1, -beta, -alpha, new_pv);
         p->UndoMove(move, u);
@@ -300,8 +316,12 @@ int cEngine::Quiesce(POS *p, int ply, int alpha, int beta, int *pv) {
 
         // BETA CUTOFF
 
-        if (score >= beta)
+        if (score >= beta) {
+#ifdef USE_QS_HASH
+            Trans.Store(p->mHashKey, move, score, LOWER, QS_DEPTH, ply);
+#endif
             return score;
+        }
 
         // ADJUST ALPHA AND SCORE
 
@@ -314,5 +334,12 @@ int cEngine::Quiesce(POS *p, int ply, int alpha, int beta, int *pv) {
         }
     }
 
+    // SAVE RESULT IN THE TRANSPOSITION TABLE
+
+#ifdef USE_QS_HASH
+    if (*pv) Trans.Store(p->mHashKey, *pv, best, EXACT, QS_DEPTH, ply);
+    else     Trans.Store(p->mHashKey,   0, best, UPPER, QS_DEPTH, ply);
+#endif
+
     return best;
 }
@@ -26,7 +26,7 @@ bool POS::IsDraw() const {
     // Draw by repetition
 
     for (int i = 4; i <= mRevMoves; i += 2)
-        if (mHashKey == mRepList[mHead - i]) return true;
+        if (mHashKey == RepKey(i)) return true;
 
     // With no major pieces on the board, we have some heuristic draws to consider
 
@@ -55,6 +55,43 @@ bool POS::IsDraw() const {
     return false;
 }
 
+// HasGameCycle() detects a repetition one ply earlier than IsDraw(): is there
+// a reversible move for the side to move that leads to an earlier position?
+// The difference of hash keys is looked up in the cuckoo tables, see InitCuckoo().
+
+bool POS::HasGameCycle(int ply) const {
+
+    if (mRevMoves < 3) return false;
+
+    for (int i = 3; i <= mRevMoves; i += 2) {
+        U64 move_key = mHashKey ^ RepKey(i);
+        int j = CuckooH1(move_key);
+
+        if (msCuckooKey[j] != move_key) {
+            j = CuckooH2(move_key);
+            if (msCuckooKey[j] != move_key) continue;
+        }
+
+        int s1 = Fsq(msCuckooMove[j]);
+        int s2 = Tsq(msCuckooMove[j]);
+
+        // the move must not be blocked
+
+        if (BB.Between(s1, s2) & OccBb()) continue;
+
+        // cycle within the search tree
+
+        if (ply > i) return true;
+
+        // earlier position comes from the game: the piece must belong to the side to move
+        // (a single repetition is a draw, as in IsDraw())
+
+        if (Cl(mPc[mPc[s1] == NO_PC ? s2 : s1]) == mSide) return true;
+    }
+
+    return false;
+}
+
 bool POS::KPKdraw(eColor sd) const {
 
     eColor op = ~sd;
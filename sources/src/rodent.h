@@ -39,6 +39,8 @@ If not, see <http://www.gnu.org/licenses/>.
 
 #include <cstdint>
 #include <cinttypes>
+#include <memory>
+#include <atomic>
 
 using U64 = uint64_t;
 
@@ -49,11 +51,55 @@ using U64 = uint64_t;
     #define USE_MM_POPCNT
 #endif
 #define USE_FIRST_ONE_INTRINSICS
+
+// x86-64 builds that don't assume POPCNT check the cpu at startup and use the popcnt
+// instruction if it is there (see cCpu), disabled by NO_CPU_DISPATCH
+#if !defined(NO_CPU_DISPATCH) && ((defined(__GNUC__) && defined(__x86_64__) && !defined(__POPCNT__)) \
+                              || (defined(_MSC_VER) && defined(_WIN64) && !defined(USE_MM_POPCNT)))
+    #define USE_CPU_DISPATCH
+#endif
+
+// x86-64 builds can look up slider attacks with the BMI2 pext instruction instead of magic
+// multiplication; used if the cpu has fast pext (see cCpu), disabled by NO_PEXT
+#if !defined(NO_PEXT) && ((defined(__GNUC__) && defined(__x86_64__)) || (defined(_MSC_VER) && defined(_WIN64)))
+    #define USE_PEXT
+#endif
 //#define USE_TUNING // needs epd.cpp, long compile time, huge file!!!
 #define TEXEL_PST    // should we use Texel-tuned piece/square tables?
 
 //#define USE_RISKY_PARAMETER
 
+// transposition table probes and stores in Quiesce(), disabled by NO_QS_HASH
+#ifndef NO_QS_HASH
+    #define USE_QS_HASH
+#endif
+
+// prefetch hash table entries of a new position right after DoMove(), disabled by NO_PREFETCH
+#ifndef NO_PREFETCH
+    #define USE_PREFETCH
+#endif
+
+// lazy eval: Quiesce() stand pat returns material + pst + pawn estimate if it is
+// far outside the window (see LAZY_MARGIN), disabled by NO_LAZY_EVAL
+#ifndef NO_LAZY_EVAL
+    #define USE_LAZY_EVAL
+#endif
+
+// compute full eval after every lazy exit and report how often it was wrong in `bench`
+//#define USE_LAZY_EVAL_STATS
+
+// count prunings, reductions and extensions by depth in search and how often they
+// turn out wrong, uci command `stats` prints them (see stats.cpp)
+//#define USE_STATS
+
+// record a timeline of each search thread (iterations, aspiration windows, root move
+// changes, skipped depths, aborts), uci command `trace` writes it as a Chrome trace
+//#define USE_TRACE
+
+// time spent in each part of Evaluate(), per thread; uci command `evalprofile` prints it
+// (see eval_profile.cpp). Timers add their own overhead, so compare parts, not builds
+//#define USE_EVAL_PROFILE
+
 // max size of an opening book to fully cache in memory (in MB)
 #ifndef NO_BOOK_IN_MEMORY
     #define BOOK_IN_MEMORY_MB 16
@@ -96,7 +142,7 @@ enum eSquare {
 // ~ switches color
 // ++ (placed before variable) iterates
 
-inline eColor operator~(eColor c) { return eColor(c ^ BC); }
+constexpr eColor operator~(eColor c) { return eColor(c ^ BC); }
 inline eColor operator++(eColor& c) { return c = eColor(int(c) + 1); }
 
 constexpr int PHA_MG = Q;
@@ -111,6 +157,9 @@ constexpr int MATE      = 32000;
 constexpr int MAX_EVAL  = 29999;
 constexpr int MAX_HIST  = 1 << 15;
 constexpr int MAX_PV    = 12;
+constexpr int REP_LIST_SIZE = 128; // ring buffer of past hash keys, power of 2 and more than 100 plies (50 move rule)
+constexpr int CUCKOO_SIZE   = 8192; // holds the 3668 reversible piece moves, used for the upcoming repetition test
+constexpr int QS_DEPTH  = -1; // hash depth of captures-only quiescence nodes (QuiesceChecks() uses 0)
 
 constexpr U64 RANK_1_BB = 0x00000000000000FF;
 constexpr U64 RANK_2_BB = 0x000000000000FF00;
@@ -161,9 +210,22 @@ template<typename T> constexpr T Clip(const T& sc, const T& lim) { if (sc < -lim
 
 #define SqBb(x)         (UINT64_C(1) << (x))
 
+// Packed evaluation score: midgame value in the lower and endgame value in the upper
+// 16 bits, so that both halves are added or subtracted with a single instruction.
+// Totals of one side must fit in 16 bits, unpack them with MgScore() and EgScore().
+// Piece values are kept out of packed scores (see sMaterialEntry::piece_value), since
+// with the material weights the uci options allow they could wrap around.
+
+using tScore = int32_t;
+
+constexpr tScore S(int mg, int eg) { return (tScore)((uint32_t)eg << 16) + mg; }
+constexpr int MgScore(tScore sc) { return (int16_t)(uint16_t)(uint32_t)sc; }
+constexpr int EgScore(tScore sc) { return (int16_t)(uint16_t)((uint32_t)(sc + 0x8000) >> 16); }
+
 #define Cl(x)           ((x) & 1)
 #define Tp(x)           ((x) >> 1)
 #define Pc(x, y)        (((y) << 1) | (x))
+#define MatKey(x, y)    (UINT64_C(1) << (4 * Pc(x, y))) // one piece in POS::mMaterialKey
 
 #define File(x)         ((x) & 7)
 #define Rank(x)         ((x) >> 3)
@@ -245,6 +307,17 @@ template<typename T> constexpr T Clip(const T& sc, const T& lim) { if (sc < -lim
     #define FirstOne(x)     bit_table[(((x) & (~(x) + 1)) * (U64)0x0218A392CD3D5DBF) >> 58] // first "1" in a bitboard
 #endif
 
+// Compiler dependent cache prefetch, a no-op if USE_PREFETCH is not defined
+
+#if defined(USE_PREFETCH) && defined(_MSC_VER)
+    #include <xmmintrin.h>
+    #define Prefetch(addr)  _mm_prefetch((const char *)(addr), _MM_HINT_T0)
+#elif defined(USE_PREFETCH) && defined(__GNUC__)
+    #define Prefetch(addr)  __builtin_prefetch(addr)
+#else
+    #define Prefetch(addr)
+#endif
+
 constexpr U64 bbNotA = ~FILE_A_BB; // 0xfefefefefefefefe
 constexpr U64 bbNotH = ~FILE_H_BB; // 0x7f7f7f7f7f7f7f7f
 
@@ -257,57 +330,364 @@ constexpr U64 ShiftNE(const U64& x)    { return (x & bbNotH) << 9; }
 constexpr U64 ShiftSW(const U64& x)    { return (x & bbNotA) >> 9; }
 constexpr U64 ShiftSE(const U64& x)    { return (x & bbNotH) >> 7; }
 
+// color-templated pawn direction helpers, so that the side is a compile-time constant
+
+template<eColor sd> constexpr U64 ShiftFwd(const U64& x)     { return sd == WC ? ShiftNorth(x) : ShiftSouth(x); }
+template<eColor sd> constexpr U64 PawnCaptWest(const U64& x) { return sd == WC ? ShiftNW(x) : ShiftSW(x); }
+template<eColor sd> constexpr U64 PawnCaptEast(const U64& x) { return sd == WC ? ShiftNE(x) : ShiftSE(x); }
+template<eColor sd> constexpr U64 PawnControl(const U64& x)  { return PawnCaptWest<sd>(x) | PawnCaptEast<sd>(x); }
+
+template<eColor sd> constexpr U64 FillFwd(U64 x) {
+    return sd == WC ? (x |= x << 8, x |= x << 16, x | x << 32)
+                    : (x |= x >> 8, x |= x >> 16, x | x >> 32);
+}
+
+template<eColor sd> constexpr U64 FrontSpan(const U64& x)    { return FillFwd<sd>(ShiftFwd<sd>(x)); }
+
+// Kogge-Stone fills of bb_start through empty squares bb_block, used for slider attacks
+// without magics and to generate the pext tables
+
+constexpr U64 FillOcclSouth(U64 bb_start, U64 bb_block) {
+
+    bb_start |= bb_block & (bb_start >> 8);
+    bb_block &= (bb_block >> 8);
+    bb_start |= bb_block & (bb_start >> 16);
+    bb_block &= (bb_block >> 16);
+    bb_start |= bb_block & (bb_start >> 32);
+    return bb_start;
+}
+
+constexpr U64 FillOcclNorth(U64 bb_start, U64 bb_block) {
+
+    bb_start |= bb_block & (bb_start << 8);
+    bb_block &= (bb_block << 8);
+    bb_start |= bb_block & (bb_start << 16);
+    bb_block &= (bb_block << 16);
+    bb_start |= bb_block & (bb_start << 32);
+    return bb_start;
+}
+
+constexpr U64 FillOcclEast(U64 bb_start, U64 bb_block) {
+
+    bb_block &= bbNotA;
+    bb_start |= bb_block & (bb_start << 1);
+    bb_block &= (bb_block << 1);
+    bb_start |= bb_block & (bb_start << 2);
+    bb_block &= (bb_block << 2);
+    bb_start |= bb_block & (bb_start << 4);
+    return bb_start;
+}
+
+constexpr U64 FillOcclNE(U64 bb_start, U64 bb_block) {
+
+    bb_block &= bbNotA;
+    bb_start |= bb_block & (bb_start << 9);
+    bb_block &= (bb_block << 9);
+    bb_start |= bb_block & (bb_start << 18);
+    bb_block &= (bb_block << 18);
+    bb_start |= bb_block & (bb_start << 36);
+    return bb_start;
+}
+
+constexpr U64 FillOcclSE(U64 bb_start, U64 bb_block) {
+
+    bb_block &= bbNotA;
+    bb_start |= bb_block & (bb_start >> 7);
+    bb_block &= (bb_block >> 7);
+    bb_start |= bb_block & (bb_start >> 14);
+    bb_block &= (bb_block >> 14);
+    bb_start |= bb_block & (bb_start >> 28);
+    return bb_start;
+}
+
+constexpr U64 FillOcclWest(U64 bb_start, U64 bb_block) {
+
+    bb_block &= bbNotH;
+    bb_start |= bb_block & (bb_start >> 1);
+    bb_block &= (bb_block >> 1);
+    bb_start |= bb_block & (bb_start >> 2);
+    bb_block &= (bb_block >> 2);
+    bb_start |= bb_block & (bb_start >> 4);
+    return bb_start;
+}
+
+constexpr U64 FillOcclSW(U64 bb_start, U64 bb_block) {
+
+    bb_block &= bbNotH;
+    bb_start |= bb_block & (bb_start >> 9);
+    bb_block &= (bb_block >> 9);
+    bb_start |= bb_block & (bb_start >> 18);
+    bb_block &= (bb_block >> 18);
+    bb_start |= bb_block & (bb_start >> 36);
+    return bb_start;
+}
+
+constexpr U64 FillOcclNW(U64 bb_start, U64 bb_block) {
+
+    bb_block &= bbNotH;
+    bb_start |= bb_block & (bb_start << 7);
+    bb_block &= (bb_block << 7);
+    bb_start |= bb_block & (bb_start << 14);
+    bb_block &= (bb_block << 14);
+    bb_start |= bb_block & (bb_start << 28);
+    return bb_start;
+}
+
 constexpr bool MoreThanOne(const U64& bb) { return bb & (bb - 1); }
 
-// bitboard functions
+// Instruction set levels, each one includes the previous ones. Detected once
+// at startup, the environment variable RIIICPU (generic, popcnt, bmi2, avx2)
+// can lower the level, e.g. to compare speed or node counts on one machine.
+
+enum eCpuLevel { CPU_GENERIC, CPU_POPCNT, CPU_BMI2, CPU_AVX2 };
 
-int PopCnt(U64);
-int PopFirstBit(U64 *bb);
+class cCpu {
+  public:
+    eCpuLevel detected;   // best level supported by the cpu
+    eCpuLevel level;      // level in use
+    bool use_popcnt;      // PopCnt() uses the popcnt instruction
+    bool slow_pext;       // pext is microcoded (AMD before Zen 3), magics are faster
+    bool use_pext;        // slider attacks come from pext-indexed tables
+
+    void Init();
+    static const char *Name(eCpuLevel lv);
+};
+
+extern cCpu Cpu;
+
+// bitboard functions, all inline so that they cost no call even without LTO
+
+constexpr int PopCntGeneric(U64 bb) { // general purpose population count
+
+    bb -= (bb >> 1) & UINT64_C(0x5555555555555555);
+    bb = (bb & UINT64_C(0x3333333333333333)) + ((bb >> 2) & UINT64_C(0x3333333333333333));
+    bb = (bb + (bb >> 4)) & UINT64_C(0x0F0F0F0F0F0F0F0F);
+    return (int)((bb * UINT64_C(0x0101010101010101)) >> 56);
+}
+
+#if defined(__GNUC__)
+
+    #if defined(__SSSE3__) && !defined(__POPCNT__) // only for ssse3 targets
+        #include "popcnt_ssse3.h"
+        #define popcnt_gcc(x) popcnt_ssse3(x)
+    #else
+        #define popcnt_gcc(x) __builtin_popcountll(x)
+    #endif
+
+    // with USE_CPU_DISPATCH the popcnt instruction is emitted directly, as the compiler
+    // is not allowed to use it in this build; the branch on a global flag is always predicted
+
+    inline int PopCnt(U64 bb) {
+    #ifdef USE_CPU_DISPATCH
+        if (Cpu.use_popcnt) {
+            U64 cnt;
+            __asm__("popcntq %1, %0" : "=r" (cnt) : "r" (bb));
+            return (int)cnt;
+        }
+    #endif
+        return popcnt_gcc(bb);
+    }
+
+#elif defined(USE_MM_POPCNT)
+
+    #include <nmmintrin.h>
+
+    inline int PopCnt(U64 bb) {
+    #ifndef _M_AMD64 // 32 bit windows
+        return _mm_popcnt_u32((unsigned int)(bb >> 32)) + _mm_popcnt_u32((unsigned int)(bb));
+    #else            // 64 bit windows
+        return (int)_mm_popcnt_u64(bb);
+    #endif
+    }
+
+#else
+
+    inline int PopCnt(U64 bb) {
+    #ifdef USE_CPU_DISPATCH
+        if (Cpu.use_popcnt) return (int)__popcnt64(bb);
+    #endif
+        return PopCntGeneric(bb);
+    }
+
+#endif
+
+inline int PopFirstBit(U64 *bb) {
+
+    U64 bb_local = *bb;
+    *bb &= (*bb - 1);
+    return FirstOne(bb_local);
+}
+
+#ifdef USE_PEXT
+    #if defined(_MSC_VER) || defined(__BMI2__)
+        #include <immintrin.h>
+    #endif
+
+inline U64 Pext(U64 bb, U64 mask) {
+
+    #if defined(_MSC_VER) || defined(__BMI2__)
+    return _pext_u64(bb, mask);
+    #else
+    U64 res;
+    __asm__("pextq %2, %1, %0" : "=r" (res) : "r" (bb), "r" (mask));
+    return res;
+    #endif
+}
+#endif
+
+#include "magicmoves.h"
+
+// attack tables that don't depend on occupancy, generated at compile time
+
+struct sStepAttacks {
+    U64 pawn[2][64];
+    U64 knight[64];
+    U64 king[64];
+};
+
+constexpr sStepAttacks MakeStepAttacks() {
+
+    sStepAttacks t = {};
+
+    for (int sq = 0; sq < 64; sq++) {
+        t.pawn[WC][sq] = ShiftNE(SqBb(sq)) | ShiftNW(SqBb(sq));
+        t.pawn[BC][sq] = ShiftSE(SqBb(sq)) | ShiftSW(SqBb(sq));
+
+        U64 bb_west = ShiftWest(SqBb(sq));
+        U64 bb_east = ShiftEast(SqBb(sq));
+        t.knight[sq] = (bb_east | bb_west) << 16;
+        t.knight[sq] |= (bb_east | bb_west) >> 16;
+        bb_west = ShiftWest(bb_west);
+        bb_east = ShiftEast(bb_east);
+        t.knight[sq] |= (bb_east | bb_west) << 8;
+        t.knight[sq] |= (bb_east | bb_west) >> 8;
+
+        t.king[sq] = SqBb(sq) | ShiftWest(SqBb(sq)) | ShiftEast(SqBb(sq));
+        t.king[sq] |= ShiftNorth(t.king[sq]) | ShiftSouth(t.king[sq]);
+    }
+    return t;
+}
+
+// from Laser, originally from chessprogramming wiki
+
+constexpr U64 GetBetween(int sq1, int sq2) {
+
+    #pragma warning( suppress : 4146 )
+    const U64 m1 = C64(-1);
+    const U64 a2a7 = C64(0x0001010101010100);
+    const U64 b2g7 = C64(0x0040201008040200);
+    const U64 h1b7 = C64(0x0002040810204080); /* Thanks Dustin, g2b7 did not work for c1-a3 */
+
+    U64 btwn = (m1 << sq1) ^ (m1 << sq2);
+    U64 file = (sq2 & 7) - (sq1 & 7);
+    U64 rank = ((sq2 | 7) - sq1) >> 3;
+    U64 line = ((file & 7) - 1) & a2a7; /* a2a7 if same file */
+    line += 2 * (((rank & 7) - 1) >> 58); /* b1g1 if same rank */
+    line += (((rank - file) & 15) - 1) & b2g7; /* b2g7 if same diagonal */
+    line += (((rank + file) & 15) - 1) & h1b7; /* h1b7 if same antidiag */
+    #pragma warning( suppress : 4146 )
+    line *= btwn & -btwn; /* mul acts like shift by smaller square */
+    return line & btwn;   /* return the bits on that line in-between */
+}
+
+struct sBetween {
+    U64 bb[64][64];
+};
+
+constexpr sBetween MakeBetween() {
+
+    sBetween t = {};
+
+    for (int sq1 = 0; sq1 < 64; sq1++)
+        for (int sq2 = 0; sq2 < 64; sq2++)
+            t.bb[sq1][sq2] = GetBetween(sq1, sq2);
+    return t;
+}
+
+#ifdef USE_PEXT
+struct sPextSlider {
+    U64 mask;       // relevant occupancy, board edges excluded
+    const U64 *att; // 2^popcnt(mask) attack sets
+};
+#endif
+
+// All tables, magic and pext slider tables included, are generated at compile time;
+// Init() only checks pext lookups against magics. Member functions are static,
+// calls through the BB object are kept for readability.
 
 class cBitBoard {
   private:
-    U64 p_attacks[2][64];
-    U64 n_attacks[64];
-    U64 k_attacks[64];
-
-#ifndef USE_MAGIC
-    U64 FillOcclSouth(U64 bb_start, U64 bb_block);
-    U64 FillOcclNorth(U64 bb_start, U64 bb_block);
-    U64 FillOcclEast(U64 bb_start, U64 bb_block);
-    U64 FillOcclWest(U64 bb_start, U64 bb_block);
-    U64 FillOcclNE(U64 bb_start, U64 bb_block);
-    U64 FillOcclNW(U64 bb_start, U64 bb_block);
-    U64 FillOcclSE(U64 bb_start, U64 bb_block);
-    U64 FillOcclSW(U64 bb_start, U64 bb_block);
+    static constexpr sStepAttacks msStep = MakeStepAttacks();
+    static constexpr sBetween msBetween = MakeBetween();
+#ifdef USE_PEXT
+    static const sPextSlider msPextR[64];
+    static const sPextSlider msPextB[64];
 #endif
 
-    U64 GetBetween(int sq1, int sq2);
+#ifdef USE_PEXT
+    static bool PextMatchesMagics();
+#endif
 
   public:
-    U64 bbBetween[64][64];
-    void Init();
-    void Print(U64 bb);
-    U64 ShiftFwd(U64 bb, eColor sd);
-    U64 ShiftSideways(U64 bb);
-    U64 GetWPControl(U64 bb);
-    U64 GetBPControl(U64 bb);
-    U64 GetPawnControl(U64 bb, eColor sd);
-    U64 GetDoubleWPControl(U64 bb);
-    U64 GetDoubleBPControl(U64 bb);
-    U64 GetFrontSpan(U64 bb, eColor sd);
-    U64 FillNorth(U64 bb);
-    U64 FillSouth(U64 bb);
-    U64 FillNorthSq(int sq);
-    U64 FillSouthSq(int sq);
-    U64 FillNorthExcl(U64 bb);
-    U64 FillSouthExcl(U64 bb);
-
-    U64 PawnAttacks(eColor sd, int sq);
-    U64 KingAttacks(int sq);
-    U64 KnightAttacks(int sq);
-    U64 RookAttacks(U64 occ, int sq);
-    U64 BishAttacks(U64 occ, int sq);
-    U64 QueenAttacks(U64 occ, int sq);
+    static void Init();
+    static void Print(U64 bb);
+
+    static constexpr U64 ShiftFwd(U64 bb, eColor sd)       { return sd == WC ? ShiftNorth(bb) : ShiftSouth(bb); }
+    static constexpr U64 ShiftSideways(U64 bb)             { return ShiftWest(bb) | ShiftEast(bb); }
+    static constexpr U64 GetWPControl(U64 bb)              { return ShiftNE(bb) | ShiftNW(bb); }
+    static constexpr U64 GetBPControl(U64 bb)              { return ShiftSE(bb) | ShiftSW(bb); }
+    static constexpr U64 GetPawnControl(U64 bb, eColor sd) { return sd == WC ? GetWPControl(bb) : GetBPControl(bb); }
+    static constexpr U64 GetDoubleWPControl(U64 bb)        { return ShiftNE(bb) & ShiftNW(bb); }
+    static constexpr U64 GetDoubleBPControl(U64 bb)        { return ShiftSE(bb) & ShiftSW(bb); }
+    static constexpr U64 FillNorth(U64 bb)                 { return FillFwd<WC>(bb); }
+    static constexpr U64 FillSouth(U64 bb)                 { return FillFwd<BC>(bb); }
+    static constexpr U64 FillNorthSq(int sq)               { return FillNorth(SqBb(sq)); }
+    static constexpr U64 FillSouthSq(int sq)               { return FillSouth(SqBb(sq)); }
+    static constexpr U64 FillNorthExcl(U64 bb)             { return FillNorth(ShiftNorth(bb)); }
+    static constexpr U64 FillSouthExcl(U64 bb)             { return FillSouth(ShiftSouth(bb)); }
+    static constexpr U64 GetFrontSpan(U64 bb, eColor sd)   { return sd == WC ? FillNorthExcl(bb) : FillSouthExcl(bb); }
+    static constexpr U64 Between(int sq1, int sq2)         { return msBetween.bb[sq1][sq2]; }
+
+    static constexpr U64 PawnAttacks(eColor sd, int sq)    { return msStep.pawn[sd][sq]; }
+    static constexpr U64 KnightAttacks(int sq)             { return msStep.knight[sq]; }
+    static constexpr U64 KingAttacks(int sq)               { return msStep.king[sq]; }
+
+    static U64 RookAttacks(U64 bb_occ, int sq) {
+#ifdef USE_PEXT
+        if (Cpu.use_pext)
+            return msPextR[sq].att[Pext(bb_occ, msPextR[sq].mask)];
+#endif
+#ifdef USE_MAGIC
+        return Rmagic(sq, bb_occ);
+#else
+        U64 bb_start = SqBb(sq);
+        return ShiftNorth(FillOcclNorth(bb_start, ~bb_occ))
+             | ShiftSouth(FillOcclSouth(bb_start, ~bb_occ))
+             | ShiftEast(FillOcclEast(bb_start, ~bb_occ))
+             | ShiftWest(FillOcclWest(bb_start, ~bb_occ));
+#endif
+    }
+
+    static U64 BishAttacks(U64 bb_occ, int sq) {
+#ifdef USE_PEXT
+        if (Cpu.use_pext)
+            return msPextB[sq].att[Pext(bb_occ, msPextB[sq].mask)];
+#endif
+#ifdef USE_MAGIC
+        return Bmagic(sq, bb_occ);
+#else
+        U64 bb_start = SqBb(sq);
+        return ShiftNE(FillOcclNE(bb_start, ~bb_occ))
+             | ShiftNW(FillOcclNW(bb_start, ~bb_occ))
+             | ShiftSE(FillOcclSE(bb_start, ~bb_occ))
+             | ShiftSW(FillOcclSW(bb_start, ~bb_occ));
+#endif
+    }
+
+    static U64 QueenAttacks(U64 bb_occ, int sq) {
+        return RookAttacks(bb_occ, sq) | BishAttacks(bb_occ, sq);
+    }
+
 };
 
 extern cBitBoard BB;
@@ -323,9 +703,15 @@ struct UNDO {
 
 class POS {
     static int msCastleMask[64];
-    static U64 msZobPiece[12][64];
-    static U64 msZobCastle[16];
-    static U64 msZobEp[8];
+    static const U64 msZobPiece[12][64];
+    static const U64 msZobCastle[16];
+    static const U64 msZobEp[8];
+    static U64 msCuckooKey[CUCKOO_SIZE];
+    static int msCuckooMove[CUCKOO_SIZE];
+
+    static void InitCuckoo();
+    static int CuckooH1(U64 key) { return key & (CUCKOO_SIZE - 1); }
+    static int CuckooH2(U64 key) { return (key >> 16) & (CUCKOO_SIZE - 1); }
 
     void ClearPosition();
     void InitHashKey();
@@ -344,8 +730,7 @@ class POS {
     int mKingSq[2];
     int mPhase;
     int mCnt[2][6];
-    int mMgSc[2];
-    int mEgSc[2];
+    tScore mPstSc[2];   // piece/square score, packed
     eColor mSide;
     int mCFlags;
     int mEpSq;
@@ -353,7 +738,10 @@ class POS {
     int mHead;
     U64 mHashKey;
     U64 mPawnKey;
-    U64 mRepList[256];
+    U64 mMaterialKey;   // piece counts packed into 4-bit fields, see MatKey()
+    U64 mRepList[REP_LIST_SIZE];
+
+    U64 RepKey(int plies_ago) const { return mRepList[(mHead - plies_ago) & (REP_LIST_SIZE - 1)]; }
 
     NOINLINE static U64 Random64();
 
@@ -390,6 +778,7 @@ class POS {
     void SetPosition(const char *epd);
 
     bool IsDraw() const;
+    bool HasGameCycle(int ply) const;
     bool KPKdraw(eColor sd) const;
 
     int DrawScore() const;
@@ -402,8 +791,12 @@ class POS {
     int *GenerateCaptures(int *list) const;
     int *GenerateQuiet(int *list) const;
     int *GenerateSpecial(int *list) const;
+    template<eColor sd> int *GenerateCaptures(int *list) const;
+    template<eColor sd> int *GenerateQuiet(int *list) const;
+    template<eColor sd> int *GenerateSpecial(int *list) const;
 
     int Swap(int from, int to);
+    bool SeeGE(int move, int threshold) const;
 
     int StrToMove(char *move_str) const;
 };
@@ -433,11 +826,24 @@ struct ENTRY {
     uint8_t depth;
 };
 
+// copy of a transposition table entry, taken once per node by Trans.Probe()
+
+struct sTransProbe {
+    bool found;
+    int move;
+    int score;   // already adjusted for mate distance
+    int flags;
+    int depth;
+
+    bool Cutoff(int alpha, int beta, int min_depth) const {
+        return found && depth >= min_depth
+            && ((flags & UPPER && score <= alpha) || (flags & LOWER && score >= beta));
+    }
+};
+
 struct eData {
-    int mg[2];
-    int eg[2];
-    int mg_pawns[2];
-    int eg_pawns[2];
+    tScore sc[2];
+    tScore pawns[2];
     int att[2];
     int wood[2];
     U64 p_takes[2];
@@ -445,6 +851,8 @@ struct eData {
     U64 p_can_take[2];
     U64 all_att[2];
     U64 ev_att[2];
+    U64 passers[2];
+    U64 half_open[2];   // squares on files without own pawns
 };
 
 struct sEvalHashEntry {
@@ -452,10 +860,17 @@ struct sEvalHashEntry {
     int score;
 };
 
+// pawn hash entry keeps the score and pawn-derived bitboards needed by the rest of eval
+// (king shelter and storm depend on pawns and kings only, so they are a part of the score)
+
 struct sPawnHashEntry {
     U64 key;
-    int mg_pawns;
-    int eg_pawns;
+    tScore pawns;
+    U64 p_takes[2];
+    U64 p_can_take[2];
+    U64 two_pawns_take[2];
+    U64 passers[2];
+    U64 half_open[2];
 };
 
 struct Line {
@@ -593,6 +1008,14 @@ const char* const paramNames[N_OF_VAL] = {
 
 #define V(x) (Par.values[x]) // a little shorthand to unclutter eval code
 
+// evaluation terms that can be switched off because their weight (or all their values) is zero
+
+enum eEvalTerm {
+    ET_MOBILITY = 1, ET_KING_ATT = 2, ET_TROPISM = 4, ET_LINES = 8, ET_FWD = 16, ET_OUTPOSTS = 32,
+    ET_CENTER = 64, ET_PASSERS = 128, ET_THREATS = 256, ET_KNIGHT_PAT = 512, ET_BISHOP_PAT = 1024,
+    ET_KING_PAT = 2048, ET_CENTRAL_PAT = 4096
+};
+
 class cParam {
   public:
 	int wait[N_OF_VAL];
@@ -620,8 +1043,10 @@ class cParam {
     int imbalance[9][9];
     int sd_att[2];
     int sd_mob[2];
-    int mg_pst[2][6][64];
-    int eg_pst[2][6][64];
+    int skip_terms[2]; // eEvalTerm flags of terms that contribute nothing for a given side
+    int mat_mg[6];    // piece values scaled by Material weight, not included in pst[]
+    int mat_eg[6];
+    tScore pst[2][6][64];
     int sp_pst[2][6][64];
     int passed_bonus_mg[2][8];
     int passed_bonus_eg[2][8];
@@ -629,14 +1054,10 @@ class cParam {
     int cand_bonus_eg[2][8];
     int mob_style;
     int pst_style;
-    int n_mob_mg[9];
-    int n_mob_eg[9];
-    int b_mob_mg[16];
-    int b_mob_eg[16];
-    int r_mob_mg[16];
-    int r_mob_eg[16];
-    int q_mob_mg[32];
-    int q_mob_eg[32];
+    tScore n_mob[9];
+    tScore b_mob[16];
+    tScore r_mob[16];
+    tScore q_mob[32];
     int danger[512];
     int np_table[9];
     int rp_table[9];
@@ -653,6 +1074,7 @@ class cParam {
     NOINLINE void DefaultWeights();
     NOINLINE void InitialPersonalityWeights();
     NOINLINE void InitAsymmetric(POS *p);
+    NOINLINE void InitSkippedTerms();
     NOINLINE void PrintValues(int startTune, int endTune);
     void Recalculate();
     void SetSpeed(int elo_in);
@@ -731,6 +1153,7 @@ class cGlobals {
     bool elo_slider;
     bool is_console;
     bool is_tuning;
+    bool is_bench;        // bench suite running, search doesn't read input
     glob_bool pondering;
     bool reading_personality;
     bool use_books_from_pers;
@@ -744,6 +1167,8 @@ class cGlobals {
     int thread_no;
 	int multiPv;
     int time_buffer;
+    int eval_hash_kb;
+    int pawn_hash_kb;
 	bool time_tricks;
     U64 game_key;         // random key initialized on ucinewgame to ensure non-repeating random eval modification for weak personalities
     int avoidMove[MAX_PV + 1]; // list of moves to avoid in multi-pv re-searches
@@ -808,12 +1233,179 @@ sInternalBook InternalBook;
 
 void CheckTimeout();
 
-constexpr int EVAL_HASH_SIZE = 512 * 512 / 4;
-constexpr int PAWN_HASH_SIZE = 512 * 512 / 4;
+// Material hash entry: everything in eval that depends on piece counts only
+
+using tScaleFunc = int (*)(POS *p, eColor sd, eColor op);
+using tEndgameFunc = int (*)(POS *p);
+
+struct sMaterialEntry {
+    U64 key;
+    int piece_value;          // piece values (white - black), already interpolated by game phase
+    int material[2];          // EvaluateMaterial(), added to both mg and eg
+    int keep[2];              // bonus for keeping pieces, applied to Par.prog_side only
+    int imbalance;
+    int draw_factor[2];       // draw factor if sd is the stronger side...
+    tScaleFunc scale[2];      // ...unless it depends on piece placement, then it's scale[sd](p, sd, op)
+    tEndgameFunc endgame;     // specialized endgame eval (white's point of view) or NULL
+};
+
+constexpr int MAT_HASH_BITS = 12; // bench 12 meets thousands of material configurations: 1.9% misses, 4% with 10 bits
+constexpr int MAT_HASH_SIZE = 1 << MAT_HASH_BITS;
+
+// Pawn hash shared by all search threads (`bench pawnhash shared KB`, otherwise every
+// thread uses its own table). It is lockless: the first word of a slot
+// holds the key xored with all data words, so a slot torn by concurrent writers
+// fails verification and is treated as a miss.
+
+constexpr int PAWN_DATA_WORDS = (sizeof(sPawnHashEntry) - sizeof(U64)) / sizeof(U64);
+static_assert(sizeof(sPawnHashEntry) == sizeof(U64) * (PAWN_DATA_WORDS + 1), "sPawnHashEntry size must be a multiple of 8 bytes.");
+
+struct sSharedPawnSlot {
+    std::atomic<U64> check;
+    std::atomic<U64> data[PAWN_DATA_WORDS];
+};
+
+class cSharedPawnHash {
+    std::unique_ptr<sSharedPawnSlot[]> mTable;
+    U64 mMask = 0;
+    int mKb = 0;
+
+  public:
+    bool Enabled() const { return mTable != nullptr; }
+    int SizeKb() const { return mKb; }
+    void Alloc(int kb);
+    void Clear();
+    bool Probe(U64 key, sPawnHashEntry *entry) const;
+    void Store(const sPawnHashEntry *entry);
+    void PrefetchSlot(U64 key) const { Prefetch(&mTable[key & mMask]); }
+};
+
+extern cSharedPawnHash SharedPawnTT;
+
+constexpr int LAZY_MARGIN = 300;   // max expected difference between lazy estimate and full eval
+constexpr int EVAL_HASH_KB = 1024; // default size of per-thread eval hash (uci option EvalHashKB, 0 = off)
+constexpr int PAWN_HASH_KB = 4096; // default size of per-thread pawn hash (uci option PawnHashKB, 0 = off)
+
+// late move reduction sizes, indexed as [is_pv][depth][moves tried]
+
+struct sLmrTable {
+    using tDepthMoves = int[MAX_PLY][MAX_MOVES];
+
+    int size[2][MAX_PLY][MAX_MOVES];
+
+    constexpr const tDepthMoves& operator[](int is_pv) const { return size[is_pv]; }
+};
+
+#ifdef USE_STATS
+
+// search statistics of one thread, counted by remaining depth
+
+enum eSearchStat {
+    ST_NODES, ST_TT_CUT, ST_SNP_TRY, ST_SNP_CUT, ST_NULL_TRY, ST_NULL_CUT, ST_NULL_VERIFY, ST_NULL_VERIFY_FAIL,
+    ST_RAZOR_TRY, ST_RAZOR_CUT, ST_IID, ST_IID_MOVE,                   // per node
+    ST_FUT_NODE, ST_FUT_PRUNED, ST_FUT_FAIL_HIGH, ST_LMR, ST_LMR_RESEARCH,
+    ST_SING_TRY, ST_SING_EXT, ST_CNT                                    // per move
+};
+
+constexpr int STATS_DEPTH = 32;     // deeper nodes are counted in the last row
+
+#endif
+
+#ifdef USE_TRACE
+
+#include <chrono>
+
+// search timeline of one thread, see trace.cpp
+
+enum eTraceEvent {
+    TR_SEARCH_BEGIN, TR_SEARCH_END, TR_ITER_BEGIN, TR_ITER_END, TR_ITER_SKIP,
+    TR_WINDOW_BEGIN, TR_WINDOW_END, TR_FAIL_LOW, TR_FAIL_HIGH, TR_ROOT_MOVE, TR_ABORT
+};
+
+struct sTraceEvent {
+    int64_t time;               // steady clock, microseconds
+    int type;
+    int depth;
+    int a, b;                   // score, window, move or skip reason, depending on type
+};
+
+// Ring buffer written only by its own search thread. The count of events written is
+// published after each event, so the uci thread can copy the last TRACE_SIZE events
+// without locking and drop those the writer may have overwritten meanwhile.
+
+struct sTraceRing {
+    static constexpr unsigned TRACE_SIZE = 1 << 14;
+
+    sTraceEvent events[TRACE_SIZE];
+    std::atomic<unsigned> count{0};
+
+    void Add(int type, int depth, int a = 0, int b = 0) {
+        const unsigned n = count.load(std::memory_order_relaxed);
+        events[n & (TRACE_SIZE - 1)] = { std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count(), type, depth, a, b };
+        count.store(n + 1, std::memory_order_release);
+    }
+};
+
+#endif
+
+#ifdef USE_EVAL_PROFILE
+
+// rdtsc ticks on x86, nanoseconds elsewhere
+
+#if (defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))) || defined(_M_X64) || defined(_M_IX86)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+    #define PROFILE_UNIT "cycles"
+    inline U64 ProfileClock() { return __rdtsc(); }
+#else
+    #include <chrono>
+    #define PROFILE_UNIT "ns"
+    inline U64 ProfileClock() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+#endif
+
+enum eEvalPart {
+    EP_EVAL, EP_HASH, EP_PAWN_STRUCT, EP_MATERIAL, EP_LAZY, EP_PIECES, EP_PASSERS,
+    EP_UNSTOPPABLE, EP_THREATS, EP_PATTERNS, EP_KING_ATTACK, EP_DRAW_FACTOR, EP_CNT
+};
+
+struct sEvalProfile {
+    U64 ticks[EP_CNT];
+    U64 calls[EP_CNT];
+    U64 hash_hits;
+    U64 lazy_exits;
+};
+
+// adds the time until the end of its scope to one part of the profile
+
+class cEvalTimer {
+    sEvalProfile *mProfile;
+    eEvalPart mPart;
+    U64 mStart;
+  public:
+    cEvalTimer(sEvalProfile *profile, eEvalPart part): mProfile(profile), mPart(part), mStart(ProfileClock()) {}
+    ~cEvalTimer() {
+        mProfile->ticks[mPart] += ProfileClock() - mStart;
+        mProfile->calls[mPart]++;
+    }
+};
+
+#endif
 
 class cEngine {
-    sEvalHashEntry mEvalTT[EVAL_HASH_SIZE];
-    sPawnHashEntry mPawnTT[PAWN_HASH_SIZE];
+    std::unique_ptr<sEvalHashEntry[]> mEvalTT; // allocated on first use by the worker, see AllocEvalHash()
+    std::unique_ptr<sPawnHashEntry[]> mPawnTT;
+    std::unique_ptr<sMaterialEntry[]> mMatTT;  // fixed size, allocated with the tables above
+    U64 mEvalHashMask = 0;
+    U64 mPawnHashMask = 0;
+    int mEvalHashKb = 0;                       // size the tables were allocated with
+    int mPawnHashKb = 0;
     int mHistory[12][64];
     int mEvalStack[MAX_PLY];
     int mKiller[MAX_PLY][2];
@@ -823,7 +1415,7 @@ class cEngine {
     bool mFlRootChoice;
 	int mEngSide;
 
-    static void InitCaptures(POS *p, MOVES *m);
+    static void InitCaptures(POS *p, MOVES *m, int trans_move);
     void InitMoves(POS *p, MOVES *m, int trans_move, int ref_move, int ref_sq, int ply);
     int NextMove(MOVES *m, int *flag, int ply);
     int NextSpecialMove(MOVES *m, int *flag);
@@ -837,6 +1429,10 @@ class cEngine {
     void AgeHist();
     void ClearEvalHash();
     void ClearPawnHash();
+    void ClearMaterialHash();
+    void AllocEvalHash();
+    void AllocPawnHash();
+    void AllocMaterialHash();
     int Refutation(int move);
     void UpdateHistory(POS *p, int last_move, int move, int depth, int ply);
     void DecreaseHistory(POS *p, int move, int depth);
@@ -852,25 +1448,28 @@ class cEngine {
     void DisplayPv(int multipv, int score, int *pv);
     void Slowdown();
     int SetNullReductionDepth(int depth, int eval, int beta);
+    void PrefetchEntries(POS *p) const;
 
-    int Evaluate(POS *p, eData *e);
+    int Evaluate(POS *p, eData *e, int alpha = -INF, int beta = INF);
 #ifdef USE_RISKY_PARAMETER
     static int EvalScaleByDepth(POS *p, int ply, int eval);
 #endif
     static int EvaluateChains(POS *p, eColor sd);
-    static void EvaluateMaterial(POS *p, eData *e, eColor sd);
-    static void EvaluatePieces(POS *p, eData *e, eColor sd);
+    static int EvaluateMaterial(POS *p, eColor sd);
+    const sMaterialEntry *ProbeMaterial(POS *p);
+    static void SetDrawFactor(POS *p, eColor sd, sMaterialEntry *me);
+    template<eColor sd> static void EvaluatePieces(POS *p, eData *e);
 	static void EvaluateShielded(POS *p, eData *e, eColor sd, int sq, int v1, int v2, int *outpost_mg, int *outpost_eg);
     static void EvaluateOutpost(POS *p, eData *e, eColor sd, int pc, int sq, int *outpost_mg, int *outpost_eg);
-    static void EvaluatePawns(POS *p, eData *e, eColor sd);
-    static void EvaluatePassers(POS *p, eData *e, eColor sd);
-    static void EvaluateKing(POS *p, eData *e, eColor sd);
+    template<eColor sd> static void EvaluatePawns(POS *p, eData *e);
+    template<eColor sd> static void EvaluatePassers(POS *p, eData *e);
+    template<eColor sd> static void EvaluateKing(POS *p, eData *e);
     static void EvaluateKingFile(POS *p, eColor sd, U64 bb_file, int *shield, int *storm);
     static int EvaluateFileShelter(U64 bb_own_pawns, eColor sd);
     static int EvaluateFileStorm(POS * p, U64 bb_opp_pawns, eColor sd);
     void EvaluatePawnStruct(POS *p, eData *e);
     static void EvaluateUnstoppable(eData *e, POS *p);
-    static void EvaluateThreats(POS *p, eData *e, eColor sd);
+    template<eColor sd> static void EvaluateThreats(POS *p, eData *e);
     static int ScalePawnsOnly(POS *p, eColor sd, eColor op);
     static int ScaleKBPK(POS *p, eColor sd, eColor op);
     static int ScaleKNPK(POS *p, eColor sd, eColor op);
@@ -882,7 +1481,8 @@ class cEngine {
     static void EvaluateKingPatterns(POS *p, eData *e);
     void EvaluateKingAttack(POS *p, eData *e, eColor sd);
     static int Interpolate(POS *p, eData *e);
-    static int GetDrawFactor(POS *p, eColor sd);
+    static int ScaleMinors(POS *p, eColor sd, eColor op);
+    static bool NeedsCheckmateHelper(POS *p);
     static int CheckmateHelper(POS *p);
     static void Add(eData *e, eColor sd, int mg_val, int eg_val);
     static void Add(eData *e, eColor sd, int val);
@@ -900,7 +1500,7 @@ class cEngine {
     static const int mscSnpDepth;      // max depth at which static null move pruning is applied
     static const int mscRazorDepth;    // max depth at which razoring is applied
     static const int mscFutDepth;      // max depth at which futility pruning is applied
-    static int msLmrSize[2][MAX_PLY][MAX_MOVES];
+    static const sLmrTable msLmrSize;
 
   public:
 
@@ -909,11 +1509,25 @@ class cEngine {
     static int msSearchDepth;
     static int msStartTime;
 
-    static void InitSearch();
-
     int mPvEng[MAX_PLY];
     int mDpCompleted;
 
+#ifdef USE_LAZY_EVAL_STATS
+    U64 mLazyExits, mLazyErrors;           // lazy eval exits and those contradicted by full eval, reset by ClearAll()
+#endif
+    U64 mEvalHashProbes, mEvalHashHits;    // hit rate counters, reset by ClearAll()
+    U64 mPawnHashProbes, mPawnHashHits;
+    U64 mTransProbes, mTransHits;          // transposition table probes in Search() and SearchRoot()
+#ifdef USE_STATS
+    U64 mStats[STATS_DEPTH][ST_CNT] = {};  // kept until `stats clear`, not reset by ClearAll()
+#endif
+#ifdef USE_TRACE
+    sTraceRing mTrace;                     // kept until `trace clear`
+#endif
+#ifdef USE_EVAL_PROFILE
+    sEvalProfile mEvalProfile = {};        // kept until `evalprofile clear`
+#endif
+
     cEngine(const cEngine&) = delete;
     cEngine& operator=(const cEngine&) = delete;
     cEngine(int th = 0): mcThreadId(th) { ClearAll(); };
@@ -932,6 +1546,10 @@ class cEngine {
     static void SetMoveTime(int base, int inc, int movestogo);
 
     void Bench(int depth);
+    void EvalBench(int reps);
+#ifdef MICROBENCH
+    void MicroBench(int reps);
+#endif
     void ClearAll();
     void Think(POS *p);
 	void MultiPv(POS *p, int * pv);
@@ -956,6 +1574,10 @@ class cEngine {
 
 void PrintVersion();
 
+void BenchSuite(const char *ptr);
+#ifdef MICROBENCH
+void MicroBench(int reps);
+#endif
 void DisplayCurrmove(int move, int tried);
 void ExtractMove(int *pv);
 int GetMS();
@@ -963,15 +1585,27 @@ U64 GetNps(int elapsed);
 bool InputAvailable();
 char *MoveToStr(int move); // returns internal static string. not thread safe!!!
 void MoveToStr(int move, char *move_str);
+FILE *OpenFromStartDir(const char *file_name, const char *mode);
 void ParseGo(POS *p, const char *ptr);
 void ParseSetoption(const char *);
 const char *ParseToken(const char *, char *);
 void PrintMove(int move);
 void PrintSingleOption(int ind);
 void PrintUciOptions();
+#ifdef USE_STATS
+void PrintSearchStats(const char *ptr);
+#endif
+#ifdef USE_EVAL_PROFILE
+void PrintEvalProfile(const char *ptr);
+#endif
+#ifdef USE_TRACE
+void WriteTrace(const char *ptr);
+#endif
 void ReadLine(char *, int);
 void ReadPersonality(const char *fileName);
 void ReadThreadNumber(const char *fileName);
+void SaveStartDir();
+int *SearchPosition(POS *p);
 void SetPieceValue(int pc, int val, int slot);
 void UciLoop();
 int my_random(int n);
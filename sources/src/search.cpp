@@ -30,7 +30,71 @@ const int cEngine::mscSelectiveDepth = Max(Max(mscSnpDepth, mscRazorDepth), mscF
 
 const int cEngine::mscRazorMargin[5] = { 0, 300, 360, 420, 480 };
 const int cEngine::mscFutMargin[7] = { 0, 100, 150, 200, 250, 300, 400 };
-int cEngine::msLmrSize[2][MAX_PLY][MAX_MOVES];
+
+// count a search event of this thread at a given depth, compiled only with USE_STATS
+
+#ifdef USE_STATS
+    #define SEARCH_STAT(st, depth) (mStats[Min(depth, STATS_DEPTH - 1)][st]++)
+#else
+    #define SEARCH_STAT(st, depth) ((void)0)
+#endif
+
+// add an event to the timeline of this thread, compiled only with USE_TRACE
+
+#ifdef USE_TRACE
+    #define SEARCH_TRACE(...) (mTrace.Add(__VA_ARGS__))
+#else
+    #define SEARCH_TRACE(...) ((void)0)
+#endif
+
+// Set depth of late move reduction (formula based on Stockfish). The table is
+// generated at compile time, so log() is replaced by a table of its values.
+
+static constexpr double lmr_log[64] = {
+    0, 0, 0.69314718055994529, 1.0986122886681098,
+    1.3862943611198906, 1.6094379124341003, 1.791759469228055, 1.9459101490553132,
+    2.0794415416798357, 2.1972245773362196, 2.3025850929940459, 2.3978952727983707,
+    2.4849066497880004, 2.5649493574615367, 2.6390573296152584, 2.7080502011022101,
+    2.7725887222397811, 2.8332133440562162, 2.8903717578961645, 2.9444389791664403,
+    2.9957322735539909, 3.044522437723423, 3.0910424533583161, 3.1354942159291497,
+    3.1780538303479458, 3.2188758248682006, 3.2580965380214821, 3.2958368660043291,
+    3.3322045101752038, 3.3672958299864741, 3.4011973816621555, 3.4339872044851463,
+    3.4657359027997265, 3.4965075614664802, 3.5263605246161616, 3.5553480614894135,
+    3.5835189384561099, 3.6109179126442243, 3.6375861597263857, 3.6635616461296463,
+    3.6888794541139363, 3.713572066704308, 3.7376696182833684, 3.7612001156935624,
+    3.784189633918261, 3.8066624897703196, 3.8286413964890951, 3.8501476017100584,
+    3.8712010109078911, 3.8918202981106265, 3.912023005428146, 3.9318256327243257,
+    3.9512437185814275, 3.970291913552122, 3.9889840465642745, 4.0073331852324712,
+    4.0253516907351496, 4.0430512678345503, 4.0604430105464191, 4.0775374439057197,
+    4.0943445622221004, 4.1108738641733114, 4.1271343850450917, 4.1431347263915326
+};
+
+constexpr sLmrTable MakeLmrTable() {
+
+    sLmrTable t = {};
+
+    for (int dp = 0; dp < MAX_PLY; dp++)
+        for (int mv = 0; mv < MAX_MOVES; mv++) {
+
+            int r = 0;
+
+            if (dp != 0 && mv != 0) {
+                // +-inf to int is undefined
+                r = (int)(0.33 + (lmr_log[Min(mv, 63)] * lmr_log[Min(dp, 63)] / 2.00));
+            }
+
+            t.size[0][dp][mv] = r;     // zero window node
+            t.size[1][dp][mv] = r - 1; // principal variation node (checking for pos. values is in `Search()`)
+
+            // reduction cannot exceed actual depth
+            if (t.size[0][dp][mv] > dp - 1) t.size[0][dp][mv] = dp - 1;
+            if (t.size[1][dp][mv] > dp - 1) t.size[1][dp][mv] = dp - 1;
+        }
+
+    return t;
+}
+
+const sLmrTable cEngine::msLmrSize = MakeLmrTable();
 
 void cParam::InitAsymmetric(POS *p) {
 
@@ -48,11 +112,14 @@ void cParam::InitAsymmetric(POS *p) {
         sd_mob[BC] = values[W_OWN_MOB];
         sd_mob[WC] = values[W_OPP_MOB];
     }
+
+    InitSkippedTerms();
 }
 
 void cGlobals::ClearData() {
 
     Trans.Clear();
+    SharedPawnTT.Clear();
 #ifndef USE_THREADS
     EngineSingle.ClearAll();
 #else
@@ -83,29 +150,6 @@ void cGlobals::SetAvoidMove(int loc, int move) {
     avoidMove[loc] = move;
 }
 
-void cEngine::InitSearch() { // static init function
-
-    // Set depth of late move reduction (formula based on Stockfish)
-
-    for (int dp = 0; dp < MAX_PLY; dp++)
-        for (int mv = 0; mv < MAX_MOVES; mv++) {
-
-            int r = 0;
-
-            if (dp != 0 && mv != 0) {
-                // +-inf to int is undefined
-                r = (int)(0.33 + (log(Min(mv, 63)) * log(Min(dp, 63)) / 2.00));
-            }
-
-            msLmrSize[0][dp][mv] = r;     // zero window node
-            msLmrSize[1][dp][mv] = r - 1; // principal variation node (checking for pos. values is in `Search()`)
-
-            // reduction cannot exceed actual depth
-            if (msLmrSize[0][dp][mv] > dp - 1) msLmrSize[0][dp][mv] = dp - 1;
-            if (msLmrSize[1][dp][mv] > dp - 1) msLmrSize[1][dp][mv] = dp - 1;
-        }
-}
-
 void cEngine::Think(POS *p) {
 
     POS curr[1];
@@ -115,8 +159,13 @@ void cEngine::Think(POS *p) {
     Glob.scoreJump = false;
     mFlRootChoice = false;
     *curr = *p;
+    AllocEvalHash();
+    AllocPawnHash();
+    AllocMaterialHash();
     AgeHist();
+    SEARCH_TRACE(TR_SEARCH_BEGIN, 0);
     Iterate(curr, mPvEng);
+    SEARCH_TRACE(TR_SEARCH_END, mDpCompleted);
     mEngSide = p->mSide;
 }
 
@@ -210,12 +259,16 @@ void cEngine::Iterate(POS *p, int *pv) {
         if (mRootDepth > 5
         && mRootDepth < msSearchDepth
         && Glob.thread_no > 1
-        && depthCounter > Glob.thread_no / 2) continue;
+        && depthCounter > Glob.thread_no / 2) {
+            SEARCH_TRACE(TR_ITER_SKIP, mRootDepth, depthCounter, 0);
+            continue;
+        }
 
         // If a thread is lagging behind too much, which makes it unlikely
         // to contribute to the final result, skip the iteration.
 
         if (Glob.depth_reached > mDpCompleted + 1) {
+            SEARCH_TRACE(TR_ITER_SKIP, mRootDepth, Glob.depth_reached, 1);
             mDpCompleted++;
             continue;
         }
@@ -223,6 +276,7 @@ void cEngine::Iterate(POS *p, int *pv) {
         // Perform actual search
 
         printf("info depth %d\n", mRootDepth);
+        SEARCH_TRACE(TR_ITER_BEGIN, mRootDepth);
 
         if (Par.search_skill > 6) {
             cur_val = Widen(p, mRootDepth, pv, cur_val);
@@ -231,7 +285,10 @@ void cEngine::Iterate(POS *p, int *pv) {
             cur_val = SearchRoot(p, 0, -INF, INF, mRootDepth, pv);
         }
 
+        SEARCH_TRACE(TR_ITER_END, mRootDepth, cur_val, (bool)Glob.abort_search);
+
         if (Glob.abort_search) {
+            SEARCH_TRACE(TR_ABORT, mRootDepth);
             break;
         }
 
@@ -272,8 +329,12 @@ int cEngine::Widen(POS *p, int depth, int *pv, int lastScore) {
         for (int margin = 8; margin < 500; margin *= 2) {
             alpha = lastScore - margin;
             beta = lastScore + margin;
+            SEARCH_TRACE(TR_WINDOW_BEGIN, depth, alpha, beta);
             cur_val = SearchRoot(p, 0, alpha, beta, depth, pv);
+            SEARCH_TRACE(TR_WINDOW_END, depth, cur_val);
             if (Glob.abort_search) break;
+            if (cur_val <= alpha) SEARCH_TRACE(TR_FAIL_LOW, depth, cur_val, margin);
+            if (cur_val >= beta)  SEARCH_TRACE(TR_FAIL_HIGH, depth, cur_val, margin);
 
             // score drops
 
@@ -303,14 +364,16 @@ int cEngine::Widen(POS *p, int depth, int *pv, int lastScore) {
         }
     }
 
+    SEARCH_TRACE(TR_WINDOW_BEGIN, depth, -INF, INF);
     cur_val = SearchRoot(p, 0, -INF, INF, depth, pv); // full window search
+    SEARCH_TRACE(TR_WINDOW_END, depth, cur_val);
     return cur_val;
 }
 
 int cEngine::SearchRoot(POS *p, int ply, int alpha, int beta, int depth, int *pv) {
 
     int best, score = -INF, move, new_depth, new_pv[MAX_PLY];
-    int mv_type, reduction, victim, last_capt, hashFlag;
+    int mv_type, reduction, victim, last_capt;
     int singMove = -1, singScore = -INF;
     int mv_tried = 0;
     int mv_played[MAX_MOVES];
@@ -319,7 +382,7 @@ int cEngine::SearchRoot(POS *p, int ply, int alpha, int beta, int depth, int *pv
     MOVES m[1];
     UNDO u[1];
     eData e;
-    int hashScore = -INF;
+    sTransProbe tte[1];
 
     bool fl_check;
     bool flExtended;
@@ -329,6 +392,7 @@ int cEngine::SearchRoot(POS *p, int ply, int alpha, int beta, int depth, int *pv
     // EARLY EXIT AND NODE INITIALIZATION
 
     Glob.nodes++;
+    SEARCH_STAT(ST_NODES, depth);
     Slowdown();
     if (Glob.abort_search && mRootDepth > 1) return 0;
     if (ply) *pv = 0;
@@ -337,14 +401,20 @@ int cEngine::SearchRoot(POS *p, int ply, int alpha, int beta, int depth, int *pv
 
     // RETRIEVE MOVE FROM TRANSPOSITION TABLE
 
-    if (Trans.Retrieve(p->mHashKey, &move, &hashScore, &hashFlag, alpha, beta, depth, ply)) {
+    Trans.Probe(p->mHashKey, tte, ply);
+    mTransProbes++;
+    mTransHits += tte->found;
+    move = tte->move;
+
+    if (tte->Cutoff(alpha, beta, depth)) {
 
-        if (hashScore >= beta) {
+        if (tte->score >= beta) {
             UpdateHistory(p, -1, move, depth, ply);
         }
 
         if (!is_pv && Par.search_skill > 0) {
-            return hashScore;
+            SEARCH_STAT(ST_TT_CUT, depth);
+            return tte->score;
         }
 
     }
@@ -352,8 +422,10 @@ int cEngine::SearchRoot(POS *p, int ply, int alpha, int beta, int depth, int *pv
     // PREPARE FOR SINGULAR EXTENSION, SENPAI-STYLE
 
     if (is_pv && depth > 5) {
-        if (Trans.Retrieve(p->mHashKey, &singMove, &singScore, &hashFlag, alpha, beta, depth - 4, ply)) {
-            if (hashFlag & LOWER) {
+        if (tte->Cutoff(alpha, beta, depth - 4)) {
+            if (tte->flags & LOWER) {
+                singMove = tte->move;
+                singScore = tte->score;
                 canSing = true;
             }
         }
@@ -375,6 +447,8 @@ int cEngine::SearchRoot(POS *p, int ply, int alpha, int beta, int depth, int *pv
     && depth > 6) {
         Search(p, ply, alpha, beta, depth - 2, false, -1, -1, pv);
         Trans.RetrieveMove(p->mHashKey, &move);
+        SEARCH_STAT(ST_IID, depth);
+        if (move) SEARCH_STAT(ST_IID_MOVE, depth);
     }
 
     // PREPARE FOR MAIN SEARCH
@@ -401,6 +475,7 @@ int cEngine::SearchRoot(POS *p, int ply, int alpha, int beta, int depth, int *pv
         }
 
         p->DoMove(move, u);
+        PrefetchEntries(p);
 
         if (p->Illegal()) {
             p->UndoMove(move, u);
@@ -453,7 +528,9 @@ int cEngine::SearchRoot(POS *p, int ply, int alpha, int beta, int depth, int *pv
             int new_alpha = -singScore - 50;
             int mockPv;
             int sc = Search(p, ply + 1, new_alpha, new_alpha + 1, depth - 4, false, -1, -1, &mockPv);
+            SEARCH_STAT(ST_SING_TRY, depth);
             if (sc <= new_alpha) {
+                SEARCH_STAT(ST_SING_EXT, depth);
                 new_depth += 1;
                 flExtended = true;
             }
@@ -486,6 +563,8 @@ int cEngine::SearchRoot(POS *p, int ply, int alpha, int beta, int depth, int *pv
             new_depth = new_depth - reduction;
         }
 
+        if (reduction) SEARCH_STAT(ST_LMR, depth);
+
     research:
 
         // PRINCIPAL VARIATION SEARCH
@@ -501,6 +580,7 @@ int cEngine::SearchRoot(POS *p, int ply, int alpha, int beta, int depth, int *pv
         // DON'T REDUCE A MOVE THAT SCORED ABOVE ALPHA
 
         if (score > alpha && reduction) {
+            SEARCH_STAT(ST_LMR_RESEARCH, depth);
             new_depth = new_depth + reduction;
             reduction = 0;
             goto research;
@@ -525,6 +605,7 @@ int cEngine::SearchRoot(POS *p, int ply, int alpha, int beta, int depth, int *pv
             // At root, change the best move and show the new pv
 
             if (!ply) {
+                if (move != *pv) SEARCH_TRACE(TR_ROOT_MOVE, depth, move, score);
                 BuildPv(pv, new_pv, move);
                 if (Glob.multiPv == 1) DisplayPv(0, score, pv);
             }
@@ -538,6 +619,7 @@ int cEngine::SearchRoot(POS *p, int ply, int alpha, int beta, int depth, int *pv
             best = score;
             if (score > alpha) {
                 alpha = score;
+                if (!ply && move != *pv) SEARCH_TRACE(TR_ROOT_MOVE, depth, move, score);
                 BuildPv(pv, new_pv, move);
                 if (Glob.multiPv == 1) DisplayPv(0, score, pv);
             }
@@ -570,8 +652,8 @@ int cEngine::SearchRoot(POS *p, int ply, int alpha, int beta, int depth, int *pv
 
 int cEngine::Search(POS *p, int ply, int alpha, int beta, int depth, bool was_null, int last_move, int last_capt_sq, int *pv) {
 
-    int best, score = -INF, null_score, move, new_depth, new_pv[MAX_PLY];
-    int mv_type, reduction, victim, last_capt, hashFlag, nullHashFlag;
+    int best, score = -INF, move, new_depth, new_pv[MAX_PLY];
+    int mv_type, reduction, victim, last_capt;
     int null_refutation = -1, ref_sq = -1, singMove = -1, singScore = -INF;
     int mv_tried = 0;
     int mv_played[MAX_MOVES];
@@ -581,7 +663,7 @@ int cEngine::Search(POS *p, int ply, int alpha, int beta, int depth, bool was_nu
     UNDO u[1];
     eData e;
     int moveSEEscore = 0; // see score of a bad capture
-    int hashScore = -INF;
+    sTransProbe tte[1];
 
     bool fl_check;
     bool flExtended;
@@ -599,12 +681,20 @@ int cEngine::Search(POS *p, int ply, int alpha, int beta, int depth, bool was_nu
     // EARLY EXIT AND NODE INITIALIZATION
 
     Glob.nodes++;
+    SEARCH_STAT(ST_NODES, depth);
     Slowdown();
     if (Glob.abort_search && mRootDepth > 1) return 0;
     *pv = 0;
     if (p->IsDraw()) return p->DrawScore();
     move = 0;
 
+    // UPCOMING REPETITION: SIDE TO MOVE CAN REPEAT AN EARLIER POSITION
+
+    if (alpha < p->DrawScore() && p->HasGameCycle(ply)) {
+        alpha = p->DrawScore();
+        if (alpha >= beta) return alpha;
+    }
+
     // MATE DISTANCE PRUNING
 
     int checkmating_score = MATE - ply;
@@ -623,28 +713,33 @@ int cEngine::Search(POS *p, int ply, int alpha, int beta, int depth, bool was_nu
         }
     }
 
-    bool hasTT = false;
-
     // RETRIEVE MOVE FROM TRANSPOSITION TABLE
 
-    if (Trans.Retrieve(p->mHashKey, &move, &hashScore, &hashFlag, alpha, beta, depth, ply)) {
+    Trans.Probe(p->mHashKey, tte, ply);
+    mTransProbes++;
+    mTransHits += tte->found;
+    move = tte->move;
+    bool hasTT = tte->Cutoff(alpha, beta, depth);
 
-        hasTT = true;
+    if (hasTT) {
 
-        if (hashScore >= beta) {
+        if (tte->score >= beta) {
             UpdateHistory(p, last_move, move, depth, ply);
         }
 
         if (!is_pv && Par.search_skill > 0) {
-            return hashScore;
+            SEARCH_STAT(ST_TT_CUT, depth);
+            return tte->score;
         }
     }
 
     // PREPARE FOR SINGULAR EXTENSION, SENPAI-STYLE
 
     if (is_pv && depth > 5) {
-        if (Trans.Retrieve(p->mHashKey, &singMove, &singScore, &hashFlag, alpha, beta, depth - 4, ply)) {
-            if (hashFlag & LOWER) {
+        if (tte->Cutoff(alpha, beta, depth - 4)) {
+            if (tte->flags & LOWER) {
+                singMove = tte->move;
+                singScore = tte->score;
                 canSing = true;
             }
         }
@@ -675,8 +770,8 @@ int cEngine::Search(POS *p, int ply, int alpha, int beta, int depth, bool was_nu
     // ADJUST EVAL USING HASH SCORE,THEN SAVE TO STACK
 
     if (hasTT) {
-        if (hashFlag & (hashScore > eval ? LOWER : UPPER))
-            eval = hashScore;
+        if (tte->flags & (tte->score > eval ? LOWER : UPPER))
+            eval = tte->score;
     }
 
     mEvalStack[ply] = eval;
@@ -700,7 +795,11 @@ int cEngine::Search(POS *p, int ply, int alpha, int beta, int depth, bool was_nu
     && p->MayNull()
     && !was_null) {
         int sc = eval - (155 - 50 * improving) * depth;
-        if (sc > beta) return sc;
+        SEARCH_STAT(ST_SNP_TRY, depth);
+        if (sc > beta) {
+            SEARCH_STAT(ST_SNP_CUT, depth);
+            return sc;
+        }
     }
 
     // NULL MOVE
@@ -721,18 +820,20 @@ int cEngine::Search(POS *p, int ply, int alpha, int beta, int depth, bool was_nu
         // omit null move search if normal search to the same depth wouldn't exceed beta
         // (sometimes we can check it for free via hash table)
 
-        if (Trans.Retrieve(p->mHashKey, &move, &null_score, &nullHashFlag, alpha, beta, new_depth, ply)) {
-            if (null_score < beta) goto avoid_null;
+        if (tte->Cutoff(alpha, beta, new_depth)) {
+            if (tte->score < beta) goto avoid_null;
         }
 
+        SEARCH_STAT(ST_NULL_TRY, depth);
         p->DoNull(u);
+        PrefetchEntries(p);
         if (new_depth <= 0) score = -QuiesceChecks(p, ply + 1, -beta, -beta + 1, new_pv);
         else                score = -Search(p, ply + 1, -beta, -beta + 1, new_depth, true, 0, -1, new_pv);
 
         // get location of a piece whose capture refuted null move
         // its escape will be prioritised in the move ordering
 
-        Trans.Retrieve(p->mHashKey, &null_refutation, &null_score, &nullHashFlag, alpha, beta, depth, ply);
+        Trans.RetrieveMove(p->mHashKey, &null_refutation);
         if (null_refutation > 0) ref_sq = Tsq(null_refutation);
 
         p->UndoNull(u);
@@ -746,11 +847,17 @@ int cEngine::Search(POS *p, int ply, int alpha, int beta, int depth, bool was_nu
 
             // verification search
 
-            if (new_depth > 6 && Par.search_skill > 9)
+            if (new_depth > 6 && Par.search_skill > 9) {
                 score = Search(p, ply, alpha, beta, new_depth - 5, true, last_move, last_capt_sq, pv);
+                SEARCH_STAT(ST_NULL_VERIFY, depth);
+                if (score < beta) SEARCH_STAT(ST_NULL_VERIFY_FAIL, depth);
+            }
 
             if (Glob.abort_search && mRootDepth > 1) return 0;
-            if (score >= beta) return score;
+            if (score >= beta) {
+                SEARCH_STAT(ST_NULL_CUT, depth);
+                return score;
+            }
         }
     } // end of null move code
 
@@ -768,7 +875,11 @@ avoid_null:
 
         if (eval < threshold) {
             score = QuiesceChecks(p, ply, alpha, beta, pv);
-            if (score < threshold) return score;
+            SEARCH_STAT(ST_RAZOR_TRY, depth);
+            if (score < threshold) {
+                SEARCH_STAT(ST_RAZOR_CUT, depth);
+                return score;
+            }
         }
     } // end of razoring code
 
@@ -780,6 +891,8 @@ avoid_null:
     && depth > 6) {
         Search(p, ply, alpha, beta, depth - 2, false, -1, last_capt_sq, pv);
         Trans.RetrieveMove(p->mHashKey, &move);
+        SEARCH_STAT(ST_IID, depth);
+        if (move) SEARCH_STAT(ST_IID_MOVE, depth);
     }
 
     // TODO: internal iterative deepening in cut nodes
@@ -801,7 +914,10 @@ avoid_null:
         && quiet_tried == 0
         && fl_prunable_node
         && depth <= mscFutDepth) {
-            if (eval + mscFutMargin[depth] < beta) fl_futility = true;
+            if (eval + mscFutMargin[depth] < beta) {
+                fl_futility = true;
+                SEARCH_STAT(ST_FUT_NODE, depth);
+            }
         }
 
         // GET MOVE HISTORY SCORE
@@ -822,6 +938,7 @@ avoid_null:
         // MAKE MOVE
 
         p->DoMove(move, u);
+        PrefetchEntries(p);
         if (p->Illegal()) { p->UndoMove(move, u); continue; }
 
         // GATHER INFO ABOUT THE MOVE
@@ -874,7 +991,9 @@ avoid_null:
             int new_alpha = -singScore - 50;
             int mockPv;
             int sc = Search(p, ply+1, new_alpha, new_alpha + 1, depth - 4, false, -1, -1, &mockPv);
+            SEARCH_STAT(ST_SING_TRY, depth);
             if (sc <= new_alpha) {
+                SEARCH_STAT(ST_SING_EXT, depth);
                 new_depth += 1;
                 flExtended = true;
             }
@@ -887,6 +1006,7 @@ avoid_null:
         && mv_hist_score < Par.hist_limit
         && (mv_type == MV_NORMAL)
         && mv_tried > 1) {
+            SEARCH_STAT(ST_FUT_PRUNED, depth);
             p->UndoMove(move, u);
             continue;
         }
@@ -983,6 +1103,8 @@ avoid_null:
             new_depth -= reduction;
         }
 
+        if (reduction) SEARCH_STAT(ST_LMR, depth);
+
     research:
 
         // PRINCIPAL VARIATION SEARCH
@@ -998,6 +1120,7 @@ avoid_null:
         // DON'T REDUCE A MOVE THAT SCORED ABOVE ALPHA
 
         if (score > alpha && reduction) {
+            SEARCH_STAT(ST_LMR_RESEARCH, depth);
             new_depth = new_depth + reduction;
             reduction = 0;
             goto research;
@@ -1018,6 +1141,7 @@ avoid_null:
                 }
             }
             Trans.Store(p->mHashKey, move, score, LOWER, depth, ply);
+            if (fl_futility) SEARCH_STAT(ST_FUT_FAIL_HIGH, depth);
 
             return score;
         }
@@ -1062,6 +1186,18 @@ int cEngine::SetNullReductionDepth(int depth, int eval, int beta) {
                  - Min(3, (eval - beta) / 200);
 }
 
+// PrefetchEntries() is called right after DoMove(): it asks the cpu to load
+// the hash table entries of the new position, so that they are (hopefully)
+// in cache when Trans.Retrieve(), Evaluate() and EvaluatePawnStruct() need them.
+
+void cEngine::PrefetchEntries(POS *p) const {
+
+    Trans.PrefetchBucket(p->mHashKey);
+    if (mEvalTT) Prefetch(&mEvalTT[p->mHashKey & mEvalHashMask]);
+    if (mPawnTT) Prefetch(&mPawnTT[p->mPawnKey & mPawnHashMask]);
+    else if (SharedPawnTT.Enabled()) SharedPawnTT.PrefetchSlot(p->mPawnKey);
+}
+
 U64 GetNps(int elapsed) {
 
     U64 nps = 0;
@@ -1112,7 +1248,7 @@ void CheckTimeout() {
 
     char command[80];
 
-    if (InputAvailable()) {
+    if (!Glob.is_bench && InputAvailable()) {
         ReadLine(command, sizeof(command));
         if (strcmp(command, "stop") == 0)
             Glob.abort_search = true;
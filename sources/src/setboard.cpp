@@ -65,10 +65,10 @@ void POS::SetPosition(const char *epd) {
                 if (Tp(pc_loop) == K)
                     mKingSq[Cl(pc_loop)] = i + j;
 
-                mMgSc[Cl(pc_loop)] += Par.mg_pst[Cl(pc_loop)][Tp(pc_loop)][i + j];
-                mEgSc[Cl(pc_loop)] += Par.eg_pst[Cl(pc_loop)][Tp(pc_loop)][i + j];
+                mPstSc[Cl(pc_loop)] += Par.pst[Cl(pc_loop)][Tp(pc_loop)][i + j];
                 mPhase += ph_value[Tp(pc_loop)];
                 mCnt[Cl(pc_loop)][Tp(pc_loop)]++;
+                if (Tp(pc_loop) != K) mMaterialKey += MatKey(Cl(pc_loop), Tp(pc_loop));
                 j++;
             }
             epd++;
@@ -0,0 +1,157 @@
+/*
+Rodent, a UCI chess playing engine derived from Sungorus 1.4
+Copyright (C) 2009-2011 Pablo Vazquez (Sungorus author)
+Copyright (C) 2011-2018 Pawel Koziol
+
+Rodent is free software: you can redistribute it and/or modify it under the terms of the GNU
+General Public License as published by the Free Software Foundation, either version 3 of the
+License, or (at your option) any later version.
+
+Rodent is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program.
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "rodent.h"
+
+#ifdef USE_STATS
+
+#include <cstdio>
+#include <cstring>
+
+// Search statistics (compile with USE_STATS). Every search thread counts how often each
+// pruning, reduction and extension is tried and how often it cuts, fails or has to be
+// redone, by remaining depth, see SEARCH_STAT() calls in search.cpp. Counters add up
+// over searches until `stats clear`.
+//
+//   stats              print per-depth tables (summed over threads) and a summary
+//   stats json [FILE]  print the same as json, or write it to FILE
+//   stats clear        reset the counters of all threads
+
+static const char *const stat_names[ST_CNT] = {
+    "nodes", "tt_cut", "snp_try", "snp_cut", "null_try", "null_cut", "null_verify", "null_verify_fail",
+    "razor_try", "razor_cut", "iid", "iid_move",
+    "fut_node", "fut_pruned", "fut_fail_high", "lmr", "lmr_research", "sing_try", "sing_ext"
+};
+
+static void AddStats(cEngine &engine, U64 sum[STATS_DEPTH][ST_CNT], bool clear) {
+
+    for (int d = 0; d < STATS_DEPTH; d++)
+        for (int st = 0; st < ST_CNT; st++)
+            sum[d][st] += engine.mStats[d][st];
+    if (clear) memset(engine.mStats, 0, sizeof(engine.mStats));
+}
+
+// sums counters of all threads, returns the number of threads
+
+static int SumStats(U64 sum[STATS_DEPTH][ST_CNT], bool clear) {
+
+    memset(sum, 0, sizeof(U64) * STATS_DEPTH * ST_CNT);
+#ifndef USE_THREADS
+    AddStats(EngineSingle, sum, clear);
+    return 1;
+#else
+    for (cEngine &engine : Engines)
+        AddStats(engine, sum, clear);
+    return (int)Engines.size();
+#endif
+}
+
+static double Percent(U64 part, U64 whole) {
+    return whole ? 100.0 * part / whole : 0.0;
+}
+
+static void PrintStatsTable(U64 sum[STATS_DEPTH][ST_CNT], const U64 *total, int first, int last) {
+
+    printf("%6s", "depth");
+    for (int st = first; st < last; st++)
+        printf(" %*s", (int)Max(11, (int)strlen(stat_names[st])), stat_names[st]);
+    printf("\n");
+
+    for (int d = 0; d <= STATS_DEPTH; d++) {
+        const U64 *row = d < STATS_DEPTH ? sum[d] : total;
+        bool empty = true;
+        for (int st = first; st < last; st++)
+            if (row[st]) empty = false;
+        if (empty && d < STATS_DEPTH) continue;
+
+        if (d == STATS_DEPTH)           printf("%6s", "total");
+        else if (d == STATS_DEPTH - 1)  printf("%5d+", d);
+        else                            printf("%6d", d);
+        for (int st = first; st < last; st++)
+            printf(" %*" PRIu64, (int)Max(11, (int)strlen(stat_names[st])), row[st]);
+        printf("\n");
+    }
+}
+
+static void WriteStatsJson(FILE *f, U64 sum[STATS_DEPTH][ST_CNT], const U64 *total, int threads) {
+
+    fprintf(f, "{\"threads\": %d, \"depths\": [", threads);
+    bool first_row = true;
+    for (int d = 0; d < STATS_DEPTH; d++) {
+        if (!sum[d][ST_NODES]) continue;
+        fprintf(f, "%s\n  {\"depth\": %d", first_row ? "" : ",", d);
+        for (int st = 0; st < ST_CNT; st++)
+            fprintf(f, ", \"%s\": %" PRIu64, stat_names[st], sum[d][st]);
+        fprintf(f, "}");
+        first_row = false;
+    }
+    fprintf(f, "],\n \"total\": {");
+    for (int st = 0; st < ST_CNT; st++)
+        fprintf(f, "%s\"%s\": %" PRIu64, st ? ", " : "", stat_names[st], total[st]);
+    fprintf(f, "}}\n");
+}
+
+void PrintSearchStats(const char *ptr) {
+
+    char token[180];
+    U64 sum[STATS_DEPTH][ST_CNT], total[ST_CNT] = {};
+
+    ptr = ParseToken(ptr, token);
+    const int threads = SumStats(sum, strcmp(token, "clear") == 0);
+    if (strcmp(token, "clear") == 0) return;
+
+    for (int d = 0; d < STATS_DEPTH; d++)
+        for (int st = 0; st < ST_CNT; st++)
+            total[st] += sum[d][st];
+
+    if (strcmp(token, "json") == 0) {
+        ParseToken(ptr, token);
+        if (*token == '\0') {
+            WriteStatsJson(stdout, sum, total, threads);
+            return;
+        }
+        FILE *f = OpenFromStartDir(token, "w");
+        if (f == NULL) {
+            printf("info string cannot write '%s'\n", token);
+            return;
+        }
+        WriteStatsJson(f, sum, total, threads);
+        fclose(f);
+        printf("info string search statistics written to '%s'\n", token);
+        return;
+    }
+
+    printf("search statistics, %d thread(s), depth is remaining depth of the node\n", threads);
+    PrintStatsTable(sum, total, ST_NODES, ST_FUT_NODE);
+    PrintStatsTable(sum, total, ST_FUT_NODE, ST_CNT);
+
+    printf("tt cutoffs        %5.1f%% of nodes\n", Percent(total[ST_TT_CUT], total[ST_NODES]));
+    printf("static null move  %5.1f%% of %" PRIu64 " tries cut\n", Percent(total[ST_SNP_CUT], total[ST_SNP_TRY]), total[ST_SNP_TRY]);
+    printf("null move         %5.1f%% of %" PRIu64 " tries cut, %.1f%% of %" PRIu64 " verifications failed\n",
+           Percent(total[ST_NULL_CUT], total[ST_NULL_TRY]), total[ST_NULL_TRY],
+           Percent(total[ST_NULL_VERIFY_FAIL], total[ST_NULL_VERIFY]), total[ST_NULL_VERIFY]);
+    printf("razoring          %5.1f%% of %" PRIu64 " tries cut\n", Percent(total[ST_RAZOR_CUT], total[ST_RAZOR_TRY]), total[ST_RAZOR_TRY]);
+    printf("futility          %" PRIu64 " moves pruned in %" PRIu64 " nodes, %.1f%% of them failed high anyway\n",
+           total[ST_FUT_PRUNED], total[ST_FUT_NODE], Percent(total[ST_FUT_FAIL_HIGH], total[ST_FUT_NODE]));
+    printf("lmr               %5.1f%% of %" PRIu64 " reduced moves searched again\n",
+           Percent(total[ST_LMR_RESEARCH], total[ST_LMR]), total[ST_LMR]);
+    printf("singular ext      %5.1f%% of %" PRIu64 " tries extended\n", Percent(total[ST_SING_EXT], total[ST_SING_TRY]), total[ST_SING_TRY]);
+    printf("iid               %5.1f%% of %" PRIu64 " searches found a move\n", Percent(total[ST_IID_MOVE], total[ST_IID]), total[ST_IID]);
+}
+
+#endif // USE_STATS
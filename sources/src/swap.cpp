@@ -76,3 +76,95 @@ int POS::Swap(int from, int to) {
 
     return score[0];
 }
+
+// SeeGE() answers "does this move win at least threshold?" without building
+// the whole exchange list like Swap() does. It stops as soon as the side
+// to recapture cannot change the outcome. Unlike Swap(), it knows about
+// en passant (victim is not on the target square) and promotions (gain
+// of the promoted piece, which then becomes the piece at stake).
+
+bool POS::SeeGE(int move, int threshold) const {
+
+    int from = Fsq(move);
+    int to = Tsq(move);
+    int mtype = MoveType(move);
+
+    if (mtype == CASTLE) return threshold <= 0;
+
+    U64 occ = OccBb() ^ SqBb(from);
+    int next = TpOnSq(from);  // piece standing on the target square after the move
+    int balance;              // gain of the side that just moved, minus threshold
+
+    if (mtype == EP_CAP) {
+        occ ^= SqBb(to ^ 8);
+        balance = tp_value[P];
+    } else
+        balance = tp_value[TpOnSq(to)]; // tp_value[NO_TP] == 0
+
+    if (IsProm(move)) {
+        next = PromType(move);
+        balance += tp_value[next] - tp_value[P];
+    }
+
+    balance -= threshold;
+
+    // even a free move is not enough
+
+    if (balance < 0) return false;
+
+    // still enough after losing the moving piece for nothing
+    // (also true for king moves, tp_value[K] == 0, legal ones are safe)
+
+    balance = tp_value[next] - balance;
+    if (balance <= 0) return true;
+
+    // find all attackers
+
+    U64 attackers = (AttacksTo(to) |
+                    (BB.BishAttacks(occ, to) & (mTpBb[B] | mTpBb[Q])) |
+                    (BB.RookAttacks(occ, to) & (mTpBb[R] | mTpBb[Q]))) & occ;
+
+    eColor side = (eColor)Cl(mPc[from]);
+    bool result = true;
+    U64 side_att, type_bb;
+    int type;
+
+    // iterate through recaptures; balance is from the view of the side to capture
+
+    for (;;) {
+        side = ~side;
+        side_att = attackers & mClBb[side];
+        if (!side_att) break;
+
+        result = !result;
+
+        // find next weakest attacker
+
+        for (type = P; type <= K; type++)
+            if ((type_bb = side_att & mTpBb[type]))
+                break;
+
+        // a king may capture only if the square is no longer defended
+
+        if (type == K)
+            return (attackers & mClBb[~side]) ? !result : result;
+
+        // stop if even losing this attacker does not change the outcome
+
+        balance = tp_value[type] - balance;
+        if (balance < (int)result) break;
+
+        // eliminate it from consideration and look for new x-ray attackers
+
+        #pragma warning( suppress : 4146 )
+        occ ^= type_bb & -type_bb;
+
+        if (type == P || type == B || type == Q)
+            attackers |= BB.BishAttacks(occ, to) & (mTpBb[B] | mTpBb[Q]);
+        if (type == R || type == Q)
+            attackers |= BB.RookAttacks(occ, to) & (mTpBb[R] | mTpBb[Q]);
+        attackers &= occ;
+    }
+
+    return result;
+}
@@ -0,0 +1,176 @@
+/*
+Rodent, a UCI chess playing engine derived from Sungorus 1.4
+Copyright (C) 2009-2011 Pablo Vazquez (Sungorus author)
+Copyright (C) 2011-2018 Pawel Koziol
+
+Rodent is free software: you can redistribute it and/or modify it under the terms of the GNU
+General Public License as published by the Free Software Foundation, either version 3 of the
+License, or (at your option) any later version.
+
+Rodent is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program.
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "rodent.h"
+
+#ifdef USE_TRACE
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Search timeline (compile with USE_TRACE). Each search thread records when searches,
+// iterations and aspiration windows begin and end, fail lows and fail highs, changes
+// of its best root move, depths it skipped (Lazy SMP coverage or lagging behind) and
+// aborts, see SEARCH_TRACE() calls in search.cpp. The last sTraceRing::TRACE_SIZE
+// events of every thread are kept.
+//
+//   trace [FILE]   write them as Chrome trace-event json (default trace.json), to be
+//                  opened in chrome://tracing or ui.perfetto.dev, one track per thread
+//   trace clear    forget recorded events. Resetting a ring is not safe while its
+//                  thread writes to it, so only do it between searches; `go` doesn't
+//                  return before the search ends and commands other than stop,
+//                  ponderhit and quit are dropped while it runs, so a uci gui can't
+//                  send it too early
+
+// copies the events of one thread that are not being overwritten
+
+static void CopyTrace(sTraceRing &ring, std::vector<sTraceEvent> &out) {
+
+    const unsigned size = sTraceRing::TRACE_SIZE;
+    const unsigned end = ring.count.load(std::memory_order_acquire);
+    const unsigned begin = end > size ? end - size : 0;
+
+    out.assign(end - begin, sTraceEvent());
+    for (unsigned i = begin; i < end; i++)
+        out[i - begin] = ring.events[i & (size - 1)];
+
+    // while we were copying, the writer may have reused slots of the oldest events,
+    // including slot `now`, which it fills before publishing `now + 1`
+
+    const unsigned now = ring.count.load(std::memory_order_acquire);
+    const unsigned stale = now + 1 > begin + size ? Min(now + 1 - begin - size, end - begin) : 0;
+    out.erase(out.begin(), out.begin() + stale);
+}
+
+static void WriteScore(FILE *f, const char *key, int score) {
+
+    if (score >= INF)       fprintf(f, "\"%s\": \"inf\"", key);
+    else if (score <= -INF) fprintf(f, "\"%s\": \"-inf\"", key);
+    else                    fprintf(f, "\"%s\": %d", key, score);
+}
+
+static void WriteTraceEvent(FILE *f, const sTraceEvent &ev, int64_t origin, int tid) {
+
+    char move_str[6];
+    const char *phase = "i";
+    char name[64];
+
+    switch (ev.type) {
+        case TR_SEARCH_BEGIN: phase = "B"; strcpy(name, "search"); break;
+        case TR_SEARCH_END:   phase = "E"; strcpy(name, "search"); break;
+        case TR_ITER_BEGIN:   phase = "B"; sprintf(name, "depth %d", ev.depth); break;
+        case TR_ITER_END:     phase = "E"; sprintf(name, "depth %d", ev.depth); break;
+        case TR_ITER_SKIP:    sprintf(name, "skip depth %d", ev.depth); break;
+        case TR_WINDOW_BEGIN: phase = "B"; strcpy(name, ev.b >= INF ? "full window" : "aspiration window"); break;
+        case TR_WINDOW_END:   phase = "E"; strcpy(name, "window"); break;
+        case TR_FAIL_LOW:     strcpy(name, "fail low"); break;
+        case TR_FAIL_HIGH:    strcpy(name, "fail high"); break;
+        case TR_ROOT_MOVE:    MoveToStr(ev.a, move_str); sprintf(name, "best move %s", move_str); break;
+        case TR_ABORT:        strcpy(name, "abort"); break;
+        default:              return;
+    }
+
+    fprintf(f, ",\n{\"name\": \"%s\", \"ph\": \"%s\", \"ts\": %" PRId64 ", \"pid\": 1, \"tid\": %d",
+            name, phase, ev.time - origin, tid);
+    if (*phase == 'i') fprintf(f, ", \"s\": \"t\"");
+
+    fprintf(f, ", \"args\": {\"depth\": %d", ev.depth);
+    switch (ev.type) {
+        case TR_ITER_END:
+            fprintf(f, ", ");
+            WriteScore(f, "score", ev.a);
+            fprintf(f, ", \"aborted\": %s", ev.b ? "true" : "false");
+            break;
+        case TR_ITER_SKIP:
+            if (ev.b == 0) fprintf(f, ", \"reason\": \"coverage\", \"threads at depth\": %d", ev.a);
+            else           fprintf(f, ", \"reason\": \"lagging\", \"depth reached\": %d", ev.a);
+            break;
+        case TR_WINDOW_BEGIN:
+            fprintf(f, ", ");
+            WriteScore(f, "alpha", ev.a);
+            fprintf(f, ", ");
+            WriteScore(f, "beta", ev.b);
+            break;
+        case TR_WINDOW_END:
+        case TR_ROOT_MOVE:
+            fprintf(f, ", ");
+            WriteScore(f, "score", ev.type == TR_ROOT_MOVE ? ev.b : ev.a);
+            break;
+        case TR_FAIL_LOW:
+        case TR_FAIL_HIGH:
+            fprintf(f, ", ");
+            WriteScore(f, "score", ev.a);
+            fprintf(f, ", \"margin\": %d", ev.b);
+            break;
+    }
+    fprintf(f, "}}");
+}
+
+void WriteTrace(const char *ptr) {
+
+    char file_name[180];
+    std::vector<sTraceRing *> rings;
+
+#ifndef USE_THREADS
+    rings.push_back(&EngineSingle.mTrace);
+#else
+    for (cEngine &engine : Engines)
+        rings.push_back(&engine.mTrace);
+#endif
+
+    ParseToken(ptr, file_name);
+    if (strcmp(file_name, "clear") == 0) {
+        for (sTraceRing *ring : rings)
+            ring->count.store(0, std::memory_order_release);
+        return;
+    }
+    if (*file_name == '\0') strcpy(file_name, "trace.json");
+
+    std::vector<std::vector<sTraceEvent> > events(rings.size());
+    int64_t origin = INT64_MAX;
+    int n_events = 0;
+
+    for (size_t t = 0; t < rings.size(); t++) {
+        CopyTrace(*rings[t], events[t]);
+        if (!events[t].empty() && events[t].front().time < origin)
+            origin = events[t].front().time;
+        n_events += (int)events[t].size();
+    }
+
+    FILE *f = OpenFromStartDir(file_name, "w");
+    if (f == NULL) {
+        printf("info string cannot write '%s'\n", file_name);
+        return;
+    }
+
+    fprintf(f, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    fprintf(f, "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"Rodent III\"}}");
+    for (size_t t = 0; t < rings.size(); t++) {
+        fprintf(f, ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": {\"name\": \"thread %d\"}}",
+                (int)t, (int)t);
+        for (const sTraceEvent &ev : events[t])
+            WriteTraceEvent(f, ev, origin, (int)t);
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+
+    printf("info string %d trace events of %d thread(s) written to '%s'\n", n_events, (int)rings.size(), file_name);
+}
+
+#endif // USE_TRACE
@@ -110,7 +110,7 @@ bool ChessHeapClass::Retrieve(U64 key, int *move, int *score, int *flag, int alp
         if (entry->key == key) {
             entry->date = tt_date;
             *move = entry->move;
-            if (entry->depth >= depth) {
+            if (entry->depth + QS_DEPTH >= depth) { // depth is stored with an offset, see Store()
 				*flag = entry->flags;
                 *score = entry->score;
                 if (*score < -MAX_EVAL)
@@ -134,6 +134,42 @@ bool ChessHeapClass::Retrieve(U64 key, int *move, int *score, int *flag, int alp
     return false;
 }
 
+// Probe() copies the matching entry, if any, so that the caller can make all
+// of its hash decisions (cutoff, singular extension, null move) without
+// going back to the table.
+
+bool ChessHeapClass::Probe(U64 key, sTransProbe *probe, int ply) {
+
+    probe->found = false;
+    probe->move = 0;
+
+    if (!success) return false;
+
+    ENTRY *entry = MakeAddr(key & tt_mask);
+
+    LOCK_ME_PLEASE0;
+
+    for (int i = 0; i < 4; i++) {
+        if (entry->key == key) {
+            entry->date = tt_date;
+            probe->found = true;
+            probe->move = entry->move;
+            probe->flags = entry->flags;
+            probe->depth = entry->depth + QS_DEPTH; // depth is stored with an offset, see Store()
+            probe->score = entry->score;
+            if (probe->score < -MAX_EVAL)
+                probe->score += ply;
+            else if (probe->score > MAX_EVAL)
+                probe->score -= ply;
+            break;
+        }
+        entry++;
+    }
+
+    UNLOCK_ME_PLEASE0;
+    return probe->found;
+}
+
 void ChessHeapClass::RetrieveMove(U64 key, int *move) {
 
     if (!success) return;
@@ -158,6 +194,12 @@ void ChessHeapClass::Store(U64 key, int move, int score, int flags, int depth, i
 
     if (!success) return;
 
+    // all threads store, so the flag is only written once and then just read,
+    // keeping its cache line shared
+
+    if (is_clean.load(std::memory_order_relaxed))
+        is_clean.store(false, std::memory_order_relaxed);
+
     int oldest = -1, age;
 
     if (score < -MAX_EVAL)
@@ -184,7 +226,7 @@ void ChessHeapClass::Store(U64 key, int move, int score, int flags, int depth, i
     LOCK_ME_PLEASE01;
 
     replace->key = key; replace->date = tt_date; replace->move = move;
-    replace->score = score; replace->flags = flags; replace->depth = depth;
+    replace->score = score; replace->flags = flags; replace->depth = depth - QS_DEPTH; // QS_DEPTH must fit in uint8_t
 
     UNLOCK_ME_PLEASE0;
     UNLOCK_ME_PLEASE1;
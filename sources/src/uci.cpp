@@ -17,13 +17,21 @@ If not, see <http://www.gnu.org/licenses/>.
 
 #include "rodent.h"
 #include "book.h"
+#include <cctype>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <chrono>
 
 #ifdef USE_THREADS
+    #include <condition_variable>
+    #include <mutex>
     #include <thread>
     using namespace std::literals::chrono_literals;
+
+    // wakes the timer thread of SearchPosition() when the search threads are done
+    static std::mutex timer_mutex;
+    static std::condition_variable timer_wakeup;
 #endif
 
 #if defined(_WIN32) || defined(_WIN64)
@@ -77,10 +85,14 @@ void UciLoop() {
         } else if (strcmp(token, "ucinewgame") == 0) {
             Trans.Clear();
             Glob.ClearData();
+            GuideBook.OpenPending();
+            MainBook.OpenPending();
             p->SetPosition(START_POS);
             srand(GetMS());
             Glob.game_key = p->Random64() ^ (U64) GetMS(); // so that the weakest personalities do not repeat the same game
         } else if (strcmp(token, "isready") == 0)    {
+            GuideBook.OpenPending(); // books whose name has been set are read here,
+            MainBook.OpenPending();  // so that it takes neither startup nor search time
             printf("readyok\n");
         } else if (strcmp(token, "setoption") == 0)  {
             ParseSetoption(ptr);
@@ -110,11 +122,34 @@ void UciLoop() {
             Glob.is_tuning = false;
 #endif
         } else if (strcmp(token, "bench") == 0)      {
+            const char *args = ptr;
             ptr = ParseToken(ptr, token);
+            if (*token != '\0' && !isdigit(*token))
+                BenchSuite(args);    // bench depth|nodes|movetime ... see bench.cpp
+            else
 #ifndef USE_THREADS
-            EngineSingle.Bench(atoi(token));
+                EngineSingle.Bench(atoi(token));
 #else
-            Engines.front().Bench(atoi(token));
+                Engines.front().Bench(atoi(token));
+#endif
+        } else if (strcmp(token, "evalbench") == 0)  {
+            ptr = ParseToken(ptr, token);
+#ifndef USE_THREADS
+            EngineSingle.EvalBench(atoi(token));
+#else
+            Engines.front().EvalBench(atoi(token));
+#endif
+#ifdef USE_EVAL_PROFILE
+        } else if (strcmp(token, "evalprofile") == 0) {
+            PrintEvalProfile(ptr);    // evalprofile [clear], see eval_profile.cpp
+#endif
+#ifdef USE_STATS
+        } else if (strcmp(token, "stats") == 0)      {
+            PrintSearchStats(ptr);    // stats [json [FILE] | clear], see stats.cpp
+#endif
+#ifdef USE_TRACE
+        } else if (strcmp(token, "trace") == 0)      {
+            WriteTrace(ptr);          // trace [FILE | clear], see trace.cpp
 #endif
         } else if (strcmp(token, "quit") == 0)       {
             exit(0);
@@ -338,14 +373,19 @@ void ParseGo(POS *p, const char *ptr) {
             exit(0);
     }
 
-    if (Glob.multiPv == 1) {
+    if (Glob.multiPv == 1)
+        ExtractMove(SearchPosition(p));
+}
+
+// Set engine-dependent variables and search using the designated number of threads.
+// Returns the principal variation of the thread that completed the deepest iteration.
 
-    // Set engine-dependent variables and search using the designated number of threads
+int *SearchPosition(POS *p) {
 
 #ifndef USE_THREADS
     EngineSingle.mDpCompleted = 0;
     EngineSingle.Think(p);
-    ExtractMove(EngineSingle.mPvEng);
+    return EngineSingle.mPvEng;
 #else
     Glob.goodbye = false;
 
@@ -357,12 +397,15 @@ void ParseGo(POS *p, const char *ptr) {
         engine.StartThinkThread(p);
 
     std::thread timer([] {
+        std::unique_lock<std::mutex> lock(timer_mutex);
         while (Glob.abort_search == false) {
 
             // Check for timeout every 5 milliseconds. This allows Rodent
-            // to survive extreme time controls, like 1 s + 10 ms
+            // to survive extreme time controls, like 1 s + 10 ms. Don't
+            // sleep on once the search has ended, short searches would
+            // take at least 5 ms otherwise
 
-            std::this_thread::sleep_for(5ms);
+            if (timer_wakeup.wait_for(lock, 5ms, [] { return Glob.abort_search == true; })) break;
             if (!Glob.is_tuning) CheckTimeout();
         }
     });
@@ -370,6 +413,11 @@ void ParseGo(POS *p, const char *ptr) {
     for (auto& engine: Engines)
         engine.WaitThinkThread();
 
+    // search threads have set abort_search unless we wait for "stop" (infinite or ponder),
+    // taking the lock makes sure the timer is either waiting or yet to check it
+
+    { std::lock_guard<std::mutex> lock(timer_mutex); }
+    timer_wakeup.notify_one();
     timer.join();
 
     if (Glob.goodbye)
@@ -383,66 +431,8 @@ void ParseGo(POS *p, const char *ptr) {
             best_pv = engine.mPvEng;
         }
 
-    ExtractMove(best_pv);
+    return best_pv;
 #endif
-
-    }
-
-}
-
-void cEngine::Bench(int depth) {
-
-    POS p[1];
-    int pv[MAX_PLY];
-    const char *test[] = {
-        "r1bqkbnr/pp1ppppp/2n5/2p5/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq -",       // 1.e4 c5 2.Nf3 Nc6
-        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -",   // multiple captures
-        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - -",                              // rook endgame
-        "4rrk1/pp1n3p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/4RRK1 b - - 7 19",
-        "rq3rk1/ppp2ppp/1bnpb3/3N2B1/3NP3/7P/PPPQ1PP1/2KR3R w - - 7 14",      // knight pseudo-sack
-        "r1bq1r1k/1pp1n1pp/1p1p4/4p2Q/4Pp2/1BNP4/PPP2PPP/3R1RK1 w - - 2 14",  // pawn chain
-        "r3r1k1/2p2ppp/p1p1bn2/8/1q2P3/2NPQN2/PPP3PP/R4RK1 b - - 2 15",
-        "r1bbk1nr/pp3p1p/2n5/1N4p1/2Np1B2/8/PPP2PPP/2KR1B1R w kq - 0 13",
-        "r1bq1rk1/ppp1nppp/4n3/3p3Q/3P4/1BP1B3/PP1N2PP/R4RK1 w - - 1 16",     // attack for pawn
-        "4r1k1/r1q2ppp/ppp2n2/4P3/5Rb1/1N1BQ3/PPP3PP/R5K1 w - - 1 17",        // exchange sack
-        "2rqkb1r/ppp2p2/2npb1p1/1N1Nn2p/2P1PP2/8/PP2B1PP/R1BQK2R b KQ - 0 11",
-        "r1bq1r1k/b1p1npp1/p2p3p/1p6/3PP3/1B2NN2/PP3PPP/R2Q1RK1 w - - 1 16",  // white pawn center
-        "3r1rk1/p5pp/bpp1pp2/8/q1PP1P2/b3P3/P2NQRPP/1R2B1K1 b - - 6 22",
-        "r1q2rk1/2p1bppp/2Pp4/p6b/Q1PNp3/4B3/PP1R1PPP/2K4R w - - 2 18",
-        "4k2r/1pb2ppp/1p2p3/1R1p4/3P4/2r1PN2/P4PPP/1R4K1 b - - 3 22",         // endgame
-        "3q2k1/pb3p1p/4pbp1/2r5/PpN2N2/1P2P2P/5PP1/Q2R2K1 b - - 4 26",        // both queens en prise
-        NULL
-    }; // test positions taken from DiscoCheck by Lucas Braesch
-
-    if (depth == 0) depth = 8; // so that you can call bench without parameters
-    Trans.Clear();
-    ClearAll();
-    mDpCompleted = 0; // maybe move to ClearAll()?
-    Par.shut_up = true;
-
-    printf("Bench test started (depth %d): \n", depth);
-
-    Glob.nodes = 0;
-    Glob.abort_search = false;
-    msStartTime = GetMS();
-    msSearchDepth = depth;
-
-    // search each position to desired depth
-
-    for (int i = 0; test[i]; ++i) {
-        printf("%s\n", test[i]);
-        p->SetPosition(test[i]);
-        Par.InitAsymmetric(p);
-        Glob.depth_reached = 0;
-        Iterate(p, pv);
-    }
-
-    // calculate and print statistics
-
-    int end_time = GetMS() - msStartTime;
-    unsigned int nps = (unsigned int)((Glob.nodes * 1000) / (end_time + 1));
-
-    printf("%" PRIu64 " nodes searched in %d, speed %u nps (Score: %.3f)\n", (U64)Glob.nodes, end_time, nps, (float)nps / 430914.0);
 }
 
 void POS::PrintBoard() const {
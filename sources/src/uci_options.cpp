@@ -40,6 +40,8 @@ void PrintUciOptions() {
 
 	printf("option name Clear Hash type button\n");
     printf("option name Hash type spin default 16 min 1 max 4096\n");
+    printf("option name EvalHashKB type spin default %d min 0 max 262144\n", EVAL_HASH_KB);
+    printf("option name PawnHashKB type spin default %d min 0 max 262144\n", PAWN_HASH_KB);
 #ifdef USE_THREADS
 	if (Glob.threadOverride == 0)
     printf("option name Threads type spin default %d min 1 max %d\n", Glob.thread_no, MAX_THREADS);
@@ -186,6 +188,10 @@ void ParseSetoption(const char *ptr) {
                 Engines.emplace_back(i);
         }
 #endif
+    } else if (strcmp(name, "evalhashkb") == 0)                              {
+        Glob.eval_hash_kb = atoi(value); // allocated by each engine before its next search
+    } else if (strcmp(name, "pawnhashkb") == 0)                              {
+        Glob.pawn_hash_kb = atoi(value);
     } else if (strcmp(name, "clear hash") == 0)                              {
         Trans.Clear();
     } else if (strcmp(name, "multipv") == 0)                                 {
@@ -284,3 +284,29 @@ bool ChDir(const char *new_path) {
     return chdir(new_path) == 0;
 }
 #endif
+
+// ChDir() moves the current directory around, so files named by the user
+// (bench suites) are opened relative to the directory Rodent was started in
+
+static char start_dir[1024];
+
+void SaveStartDir() {
+
+#if defined(_WIN32) || defined(_WIN64)
+    if (!GetCurrentDirectoryA(sizeof(start_dir), start_dir))
+#else
+    if (!getcwd(start_dir, sizeof(start_dir)))
+#endif
+        start_dir[0] = '\0';
+}
+
+FILE *OpenFromStartDir(const char *file_name, const char *mode) {
+
+    char path[2048];
+
+    if (isabsolute(file_name) || start_dir[0] == '\0')
+        return fopen(file_name, mode);
+
+    snprintf(path, sizeof(path), "%s/%s", start_dir, file_name);
+    return fopen(path, mode);
+}
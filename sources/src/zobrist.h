@@ -0,0 +1,234 @@
+// Zobrist keys, generated with std::mt19937_64 seeded with 2018 and
+// std::uniform_int_distribution<U64>(2^56, 2^62) from libstdc++ (GCC),
+// in the order piece[12][64], castle[16], ep[8]. Included by data.cpp.
+
+const U64 POS::msZobPiece[12][64] = {
+    { // 0
+        0x30fa3cd0f43dae4dULL, 0x0793ab785f329d5cULL, 0x131de3a329b5247eULL, 0x2e9cf5bce34bbca9ULL,
+        0x1381399983103de4ULL, 0x174909ec994b8139ULL, 0x2c464123cccc9cfcULL, 0x12139b0badb8d358ULL,
+        0x03989fb4d4e734e2ULL, 0x317e929ac3232885ULL, 0x11eac596765d819dULL, 0x35833cd9a8ba44f0ULL,
+        0x01b78b3a3a7e6bc5ULL, 0x16ad5147ce9fb216ULL, 0x36d5b69270317edcULL, 0x3fa04090aff2a93fULL,
+        0x0aeea369b5e4b914ULL, 0x0c8f6f3175bac26dULL, 0x1f0afc649f6ba1e5ULL, 0x3ec6cf6fc6885ddaULL,
+        0x1dcfa9deb370744fULL, 0x2cbc5d2c5cdc3737ULL, 0x0d0e7bec16fcbebbULL, 0x3dfab1ddbb53a249ULL,
+        0x05ff420a35a3b8fdULL, 0x2c4c110942e0b503ULL, 0x0ba280f3f7dc4034ULL, 0x31f017addc2a7c59ULL,
+        0x18bf8b362aa8b714ULL, 0x39d27084b738c0a4ULL, 0x226e520f7f500c74ULL, 0x0386a77f3d635b39ULL,
+        0x0afbe0d029d04c26ULL, 0x24a16033190e9ebaULL, 0x1eef333c71cf9ffbULL, 0x212571088e4e45a6ULL,
+        0x1ff7c37bd8ff513cULL, 0x389217cfcbadfbdfULL, 0x3d3452ad5c0c3528ULL, 0x082bac9d60d3f83aULL,
+        0x28d81d8df239b84aULL, 0x3fd57e570d974120ULL, 0x12277855a3ab0e6cULL, 0x28b566a644f64344ULL,
+        0x09ce309a95ae6b65ULL, 0x34f3040cbdbc8cc2ULL, 0x3d38f5927742901cULL, 0x14880f456992573aULL,
+        0x1af5b018225ce31eULL, 0x3578dd1d937a7c1cULL, 0x12fd09bef606be68ULL, 0x32c41fc7ace9bde8ULL,
+        0x3f6336e1d7ad3190ULL, 0x183210e217cd156bULL, 0x3d0949edc863e2d9ULL, 0x2aee5275bb59454eULL,
+        0x38be957d0bd68a12ULL, 0x1ea3726f8ad7630aULL, 0x057921c37453a54cULL, 0x2241e14b194a1eaaULL,
+        0x15cf1ad9620b3057ULL, 0x30170a6c3d7f8fd2ULL, 0x29d83aacc0f11d17ULL, 0x2113f6c8d02e63caULL,
+    },
+    { // 1
+        0x30939745eb2ca562ULL, 0x16a787a9e8e860a9ULL, 0x1e4ee69bb3c03209ULL, 0x1962979cfe6c8839ULL,
+        0x35a88bd5e8595fdeULL, 0x1bc6c24b023e5007ULL, 0x06fc82bf5ecbf702ULL, 0x2a42302e201cf634ULL,
+        0x0b9197c357e901a0ULL, 0x0c27d584fd27c8dbULL, 0x35c0ae941929b007ULL, 0x2778290d6475343eULL,
+        0x131e38abca65e9d2ULL, 0x3dd0a65f8e57b7f3ULL, 0x329fa5161b40fb77ULL, 0x33dd343fbfbaa15aULL,
+        0x0867a1af6771216fULL, 0x3f3ec23b5e465dabULL, 0x3ed9d27864bc2a58ULL, 0x0656ffd66e43d3cbULL,
+        0x3af9d7c8108fd241ULL, 0x08572e572876347fULL, 0x20c419e8fd770ee6ULL, 0x3125f5bb246db042ULL,
+        0x319d01e0a892434bULL, 0x01dfdaa4b5820aacULL, 0x1fc0c7346a6d42b8ULL, 0x0c7a099d10e9b1f0ULL,
+        0x32669e43daed5515ULL, 0x31d98eaf61b2e9ffULL, 0x1f76194801c03f56ULL, 0x1b166b6f8e6aa495ULL,
+        0x374b08336bdb8fe9ULL, 0x1792cc2ea61d66ddULL, 0x31636845f4be20f1ULL, 0x3efb1af0a4e5a9cbULL,
+        0x179cbadd72a17a88ULL, 0x06e8e164058f6a49ULL, 0x214591472d994b73ULL, 0x24fe6476519622d5ULL,
+        0x11122b508e372380ULL, 0x25768c19e93a96b7ULL, 0x31c957a76fd4c7a3ULL, 0x1127d7eac96616efULL,
+        0x3e586938842b905bULL, 0x3c77e9b14ae08bb7ULL, 0x092353323993c2c4ULL, 0x1768a5dbd50d1598ULL,
+        0x15d453b573a8a753ULL, 0x244c14113864e044ULL, 0x3da8e6b449da136aULL, 0x11c05ae5ee22e1abULL,
+        0x2c65dd12f7d54913ULL, 0x13d0df0f75cc0108ULL, 0x3dc254b330f06bccULL, 0x0a747724238e500bULL,
+        0x1c8b5ba7c6f0a9f8ULL, 0x2e4b640471b50f62ULL, 0x20eaf27808b80bbbULL, 0x3ee8b1b637b7d0aaULL,
+        0x2112bbaa00696b40ULL, 0x207ece0483d95039ULL, 0x02b8a7946433f36bULL, 0x074e3e9440bc3edbULL,
+    },
+    { // 2
+        0x11aff09cb7eff83eULL, 0x3bf4ef0afc0a14acULL, 0x28fdad634243cbedULL, 0x24d9eac8fbeaf8cdULL,
+        0x144d4ec9553fece1ULL, 0x075ba02b63c21b10ULL, 0x3208d4631fe4c61bULL, 0x2e9acf4f92b4a6c6ULL,
+        0x197d9d930651b3b0ULL, 0x2b0f5fa8011b9265ULL, 0x3279038023294433ULL, 0x30b7e89607da7d0bULL,
+        0x2eddf8acebf3b000ULL, 0x33519a93e7b94573ULL, 0x37b0cc3cc496f4acULL, 0x10bee0ba22c3ae85ULL,
+        0x0be4f3d27d2f83d3ULL, 0x25f08a8f5ce6d81bULL, 0x1ce94fc115d4dfefULL, 0x29a53103d5cdebf0ULL,
+        0x1725db479ba479b1ULL, 0x34eddc2c900bdf47ULL, 0x0f2599a0663cd16dULL, 0x32fa7c3e76151af2ULL,
+        0x10e2db31dc5c9d88ULL, 0x10af3202b98905edULL, 0x04832a2fc6e9614cULL, 0x3f240a9d434dd6b5ULL,
+        0x3fc12b844deb1d08ULL, 0x350e1a49549f4c72ULL, 0x2419d353ba5f8204ULL, 0x1704fa01e29b7081ULL,
+        0x27ab1480a877cd8bULL, 0x0ad575939700ed52ULL, 0x0d9c147cfd68c049ULL, 0x2d8e7f53faecb9f8ULL,
+        0x1da9462c39ec5654ULL, 0x24a028640c38faceULL, 0x01d60aeb50dd1834ULL, 0x28d5deffe6b27277ULL,
+        0x32e386203d38186fULL, 0x22cd75361c8ba414ULL, 0x0631ae1300da1586ULL, 0x1bec59ca3302f68cULL,
+        0x21bf15e532f6fca8ULL, 0x12f87b6b8a0b630bULL, 0x24d1ef9b3a7e2253ULL, 0x219e72edb25d6908ULL,
+        0x12f77791567be29eULL, 0x38b9864816a1a513ULL, 0x06fa6f0d9323efa8ULL, 0x0f9ee9be13ffcc15ULL,
+        0x33bf216f8a933bcaULL, 0x2dd63863895e8d19ULL, 0x0c6520ea0c3aa3feULL, 0x0b8204150241b760ULL,
+        0x0c1b48b3563f8862ULL, 0x33d30e0d45ba0e6cULL, 0x15bb07f134ff92e2ULL, 0x03f209c836d677feULL,
+        0x155ca96915260969ULL, 0x384d5f7c5171bc1fULL, 0x20e7b118a8513e21ULL, 0x282c1ec07397bdeaULL,
+    },
+    { // 3
+        0x0f580513d481ade9ULL, 0x0665e4873dae01e3ULL, 0x19c25ada50a744e5ULL, 0x1d9263e14661167cULL,
+        0x32110209fcd1624bULL, 0x032e2e0de72c789fULL, 0x1d5384c25f14d065ULL, 0x1ef2162a1b54203fULL,
+        0x1a5af66aed1555aaULL, 0x01ab935873605358ULL, 0x0cd1fe9066d5ae00ULL, 0x31e4a38d47ddde6dULL,
+        0x0f53c0672edea595ULL, 0x0f47da7b69dea278ULL, 0x3e17e26a4a89ec40ULL, 0x390523e9916bf302ULL,
+        0x20147822b106cdc3ULL, 0x2e24298b5ba9ea4bULL, 0x2975f625fa0b7803ULL, 0x26edbc9bfa2ca7f4ULL,
+        0x30e12836a8439e56ULL, 0x0e00b5fb169e8106ULL, 0x0b32fac20e6c1d82ULL, 0x0572d8afa6213340ULL,
+        0x2460cc6424d7ecb9ULL, 0x353b5c74e5a1f730ULL, 0x35f55a62e6b07270ULL, 0x0dd8c6b3bfeda8b1ULL,
+        0x39b032e1f434b0afULL, 0x0336cabb31f4937cULL, 0x3f3392644a5e12c9ULL, 0x382dfe54eaaf7fbbULL,
+        0x2ffe2bca62fa5610ULL, 0x3f39a5e721166abcULL, 0x2909c3b774b12a1fULL, 0x1eb73fe3277da391ULL,
+        0x0ece029deddcd3b7ULL, 0x058042925026bec6ULL, 0x339f757a3c819b95ULL, 0x116be02485254e7cULL,
+        0x3fab8ff44b724b54ULL, 0x25dca2de548d95c2ULL, 0x282302e106edaa52ULL, 0x3dc16e76fcc2fea3ULL,
+        0x01c9ec273f202324ULL, 0x1674b6307b714ee5ULL, 0x38593e1fbf0bed68ULL, 0x36f538f40838a6aeULL,
+        0x11508a10e7753b0bULL, 0x1df0a2b82a9f3083ULL, 0x3f33f2cadd2f60ffULL, 0x3030de8316e44be8ULL,
+        0x045c3f33ab699379ULL, 0x18dbc13ae41d5638ULL, 0x1aea3e895a8bb8e8ULL, 0x24978b3bc1eb7547ULL,
+        0x17c7f791b9db2165ULL, 0x0d9975eb07129713ULL, 0x145a964c130f5b4aULL, 0x209bfc9772eca104ULL,
+        0x1a1516b1659e9760ULL, 0x32a3e8b7f32d0dabULL, 0x3be6b3f49517b608ULL, 0x18770633dd4f457bULL,
+    },
+    { // 4
+        0x30c4d45ad6f91a8aULL, 0x3508652f32630aa9ULL, 0x2837543b820f8ab7ULL, 0x3845f9de31a8c733ULL,
+        0x100ea55578000854ULL, 0x0699aee826f065c2ULL, 0x326ad0a1e2900a0bULL, 0x2af5458edd66cb92ULL,
+        0x0a7f3659ad8e6ec5ULL, 0x13ad04b3eeb2d73bULL, 0x113ef227a5ab1a43ULL, 0x3f737fe36874ff8cULL,
+        0x08ad1d4ac762caafULL, 0x1e43095dd3ff1aafULL, 0x3b00e04783f66499ULL, 0x1944146530aeb05eULL,
+        0x221acafa8959e23bULL, 0x2bca60c9eec0d092ULL, 0x3c04e20666a2321eULL, 0x0fe34e9a27595a1bULL,
+        0x23f499c8fc7ab2a8ULL, 0x2599153ff53e257fULL, 0x3fe35b4f5eea471eULL, 0x2d8794618e0c85b1ULL,
+        0x18424460d2073ee9ULL, 0x23d8f63f0d326a8aULL, 0x1953879dd46b5c87ULL, 0x23baa2ed81ea8304ULL,
+        0x0885a1dd0c4a38eaULL, 0x0141aad112719953ULL, 0x24f4bf00d76e96d4ULL, 0x229c9249390edd32ULL,
+        0x2f9ac6e41df7f448ULL, 0x0a66aba44a2d5e6eULL, 0x0451bc391f1b3449ULL, 0x1746b1581eabe8d7ULL,
+        0x2cd3b3021371a689ULL, 0x24c9d98d9919119fULL, 0x06cde87be2279a42ULL, 0x10b17fcaaaabef00ULL,
+        0x3a659f71886a667aULL, 0x0eb1599819799d2aULL, 0x0e7888d65a87ff64ULL, 0x3eb4b91bf8c57e8bULL,
+        0x2caf5cb93c25e3a8ULL, 0x0d86a3c55e71bde9ULL, 0x33b83c312be6a210ULL, 0x0d8c69547b3e6c72ULL,
+        0x2746954bd7577c18ULL, 0x36fd10d8ef0aa18eULL, 0x3a5f88f600202a68ULL, 0x1cf5d3a2c75cdbd4ULL,
+        0x3002cf1ff1d95a11ULL, 0x2a469f619c9f1307ULL, 0x10d4628539bc0eabULL, 0x137d0299f9aa3ce2ULL,
+        0x1dc3df17b5429bedULL, 0x0436ca5c81475043ULL, 0x0aa4e72a848432bbULL, 0x3d79c3481d47bef6ULL,
+        0x041a89efcee3d85bULL, 0x39e415423841313eULL, 0x0752b8d5dcf5f97cULL, 0x2f9fca4ce9ab3619ULL,
+    },
+    { // 5
+        0x2dec1fc7e94d7e68ULL, 0x3e7f2fd29331f342ULL, 0x13c655667e9fb708ULL, 0x06ab44bac7c0a4e0ULL,
+        0x369028065937888eULL, 0x3797719594addb4bULL, 0x07ccdd49e759aaf3ULL, 0x288ea1fe858013c6ULL,
+        0x3fb60283e7d63e28ULL, 0x1b038470a3a8ad8fULL, 0x17d465339962e382ULL, 0x3fd7ddf56f905805ULL,
+        0x05dc9c1aeb9c6f5cULL, 0x186d5fe6b696ced8ULL, 0x2648c64f1f1d41a1ULL, 0x203382231bbef70aULL,
+        0x3fabe527f6eca10fULL, 0x019be534b33c9164ULL, 0x0d1d26ca0e059caaULL, 0x0334a680de370ddbULL,
+        0x0baee633ebff3ea4ULL, 0x39e3519d7342ed2fULL, 0x30090203dca28ae9ULL, 0x29287c6ba5833dffULL,
+        0x15b71801c5fcf651ULL, 0x1f892f71a223cca8ULL, 0x3e7af3c19fef6cedULL, 0x0d67c9b0873bca63ULL,
+        0x329a6e078fbd56a0ULL, 0x19c8fe0f87237d47ULL, 0x11d345097a6dbbaeULL, 0x10450598bd1f719fULL,
+        0x11f8ab8f65cea204ULL, 0x11488f7fbddeeffaULL, 0x235da2a897a0e4bbULL, 0x1592eec0e9dd3f9dULL,
+        0x34bb95679e7ee397ULL, 0x0fc025e2eae22370ULL, 0x0773635857abdc50ULL, 0x0ce3218f00c4416cULL,
+        0x147b5a0327f30c14ULL, 0x0c5d77ddbc2dd843ULL, 0x111d016d0b152403ULL, 0x04879919d97d96e3ULL,
+        0x1324953f1905226cULL, 0x245644baba6a5d28ULL, 0x2c0ad2a4a2377654ULL, 0x33de4bbba0968852ULL,
+        0x369181cf33175616ULL, 0x233d02a1b5b714c9ULL, 0x1ee669c77ee52bdfULL, 0x0f4c26253fa5876dULL,
+        0x047dc7e1a19f6c54ULL, 0x1b455068822037f5ULL, 0x29fb177bc1da1b5dULL, 0x28ebcdfda87a66eaULL,
+        0x2c25ad890adfd6baULL, 0x17835f053eba7581ULL, 0x0a0c707a2fb070d3ULL, 0x077d3347684739cbULL,
+        0x1900be941c4efaf2ULL, 0x02f2d1177ef7f399ULL, 0x1ec914842e7b4201ULL, 0x1c733d1012661f7fULL,
+    },
+    { // 6
+        0x0b35d83c25e4a353ULL, 0x1df16e7ddefc1db5ULL, 0x14ce4c2afbaa1a67ULL, 0x1c6b736dbbbfe118ULL,
+        0x18cc011f9bd403c8ULL, 0x16b7be3e72ec15c7ULL, 0x020f34015212aff6ULL, 0x0f5019fc1bdce950ULL,
+        0x2ab90ffa52b05148ULL, 0x01b20139750f01abULL, 0x1a43f8cdc67c0e8dULL, 0x2043751681a02d6eULL,
+        0x03fe116975235775ULL, 0x093736bddcf87935ULL, 0x2edbb11dbdaa3e64ULL, 0x131f6153713aef19ULL,
+        0x21f02ad07b42bd24ULL, 0x243d13de9869092cULL, 0x33d37e7a9608456bULL, 0x176d35eaf7b315d0ULL,
+        0x19f09febb9efc9e4ULL, 0x054acfc2e1c8ad75ULL, 0x24d60265aa47ed5fULL, 0x15189fd8bd2b9d56ULL,
+        0x0a3fe3ceb2dd270fULL, 0x1f1feb7abb228b47ULL, 0x06352054a6bcc65dULL, 0x35aef5fcd3ae1a41ULL,
+        0x1bb210cc4a427019ULL, 0x3ed8d2daab75f4a6ULL, 0x14ea1275091236c8ULL, 0x3746ff72017ea305ULL,
+        0x12d7a12bb16535dbULL, 0x28c26f589661b86aULL, 0x2292e4dd06255022ULL, 0x194849b0d5b92a9cULL,
+        0x08446b79abc22654ULL, 0x0df5bddde79ece17ULL, 0x36d8d62a7eb5093dULL, 0x1e90ef725a6fb76dULL,
+        0x1f63a0ac99dce337ULL, 0x3cc95b89ded30229ULL, 0x372682787e74792aULL, 0x22ae76d0a520e1a4ULL,
+        0x38c4af7611034cfaULL, 0x0df3689dee70e807ULL, 0x1de5b727ed412356ULL, 0x075816934a20d7e0ULL,
+        0x3548210b2bf701e3ULL, 0x19752183e5e44472ULL, 0x0df55fad64fea928ULL, 0x25a647b4f2815fceULL,
+        0x395b843c044e2e77ULL, 0x3595787d0f225ba7ULL, 0x06bbe4c7e0b5bc70ULL, 0x3dcb1a53283107f4ULL,
+        0x052c5bf1272f5af6ULL, 0x3921aa59a4afb464ULL, 0x08a8799f7df0eb5fULL, 0x2062c7286398a509ULL,
+        0x3a06a7ab9e994d10ULL, 0x3b014f187214cf51ULL, 0x2f83af5367f35a20ULL, 0x07adfdc0d602df82ULL,
+    },
+    { // 7
+        0x2b4c1f33d9af10d4ULL, 0x1497739ff83056b1ULL, 0x111d5ef202e7f10dULL, 0x27f3beaada4e0219ULL,
+        0x0e4cbda738eb17b1ULL, 0x0d1e56ed2d64b625ULL, 0x11b3270ffd94d7a8ULL, 0x2c4b617a7257b039ULL,
+        0x07b0e4fe79d52023ULL, 0x2bb9e83135b9e494ULL, 0x36f6992465614a93ULL, 0x3083e4aab79b219dULL,
+        0x2bb5cd13027c2404ULL, 0x13717f8b805bf259ULL, 0x163cb315e87a0919ULL, 0x2c8f3a831fe081ceULL,
+        0x2229d70d802496d9ULL, 0x0513f28dd1335d2fULL, 0x26aafc0b066fc256ULL, 0x10c84072eefde545ULL,
+        0x286a22ef32b1e57cULL, 0x3cc74731444f2e2fULL, 0x1b2db1fad0233ea2ULL, 0x1b8fb7e96874084bULL,
+        0x399885657f32365eULL, 0x05ab26a02bb23d68ULL, 0x11db61dc28fb8200ULL, 0x057c05c501853f68ULL,
+        0x0d0edcccbd1fc92cULL, 0x04b4ae47cec4c230ULL, 0x3fdcc199e8574644ULL, 0x21a3bdfc410a6e66ULL,
+        0x253bab499bca0922ULL, 0x08930e9d9ab3810fULL, 0x0da70b28cfe38c44ULL, 0x04b3c28b9a5acb27ULL,
+        0x1da1b654cdea8dc1ULL, 0x16491bc99d8b6762ULL, 0x098f01b345389573ULL, 0x0b282aec5756c377ULL,
+        0x0563c031ae940ec0ULL, 0x02e524466bb601e8ULL, 0x160747964414a083ULL, 0x0cc71c15aa8aad58ULL,
+        0x31a05e814ab6beb7ULL, 0x094fa2ea602f0de5ULL, 0x0fc6f04a3d4a4590ULL, 0x178d6cab3fe97d42ULL,
+        0x2327f799cb998decULL, 0x24648590fca0cc00ULL, 0x211bc2d956a87da7ULL, 0x2fe49f6659006f16ULL,
+        0x2a4a6869db85a7e5ULL, 0x2c9adbbb8537d060ULL, 0x3590077ae5bda0daULL, 0x3318eb295855e4f1ULL,
+        0x3cdb442ad4d3a04fULL, 0x3f555d5d0a55072cULL, 0x0589e681506887efULL, 0x39b349163c461123ULL,
+        0x270ae33635b3a432ULL, 0x175912c02942fd1aULL, 0x2f8216d8477a80e7ULL, 0x0141cac73ffe67dfULL,
+    },
+    { // 8
+        0x21bd64d33c606b82ULL, 0x030128db1be71f47ULL, 0x37dd556fbc7db830ULL, 0x2ac993958c5c2792ULL,
+        0x32bc93d816752e0eULL, 0x0b98cd44e1ef6065ULL, 0x098914de82253850ULL, 0x0572f9a5ee54664cULL,
+        0x26fea972dc61fa8eULL, 0x3c0c9c2f36ef3b10ULL, 0x1ea978970c60722cULL, 0x206485de09b10464ULL,
+        0x328d171ab7cbde18ULL, 0x34fbf22e71c1c44dULL, 0x155bb7bb8e4944c5ULL, 0x3c961db716d0f265ULL,
+        0x326077efc4dbbc9bULL, 0x1cad2d844d4fcf14ULL, 0x30323b38e6eac915ULL, 0x34129d8ed27c36e9ULL,
+        0x0284e6f7ffdbeb32ULL, 0x0439070c9af991acULL, 0x01550bf16ad5cfdfULL, 0x0fc990fffbb7057dULL,
+        0x1729829db704d139ULL, 0x28e83e7e77fb47baULL, 0x2da65a2785a0ecfaULL, 0x13d277dafa6eb0adULL,
+        0x2b9e21952bd8b051ULL, 0x2215fa86f004649fULL, 0x0be5b604aca6a087ULL, 0x07468f0fada35c99ULL,
+        0x037d866091817babULL, 0x1ba352264fcdc57eULL, 0x0ffab5a1002241e0ULL, 0x0a6cd05d599b1011ULL,
+        0x117369d8032db23dULL, 0x1c1d8a4720fd28deULL, 0x30fadd81b0ae0e3dULL, 0x282ddaa22e7b2b6eULL,
+        0x0f00c22e5b4be9a9ULL, 0x10503afc67cf322eULL, 0x1d3461fe77dc12f7ULL, 0x0a5bd1a6cb4cb639ULL,
+        0x1e686fd413300c78ULL, 0x1d23db388066b554ULL, 0x05d2d43001887fa7ULL, 0x3f2bd69be7181fcdULL,
+        0x3e10336e703db7e7ULL, 0x03aa67099b9df772ULL, 0x2b7ee81bf258044dULL, 0x2b2ed9faab8fad41ULL,
+        0x20c606829bd3c1c0ULL, 0x34f79938028c827dULL, 0x24b5ed82403b8584ULL, 0x0e23631615731fbcULL,
+        0x0a234d2f99acd93cULL, 0x1a5709d8f60833a1ULL, 0x1fb7fdf0c83101ccULL, 0x2f04fb41128026b1ULL,
+        0x3073decedd10ecc3ULL, 0x2c6e54053208a332ULL, 0x39a9e91846d34abaULL, 0x09908c5ce9094cd9ULL,
+    },
+    { // 9
+        0x1dd41c5a43e13e21ULL, 0x36da29cdbe62f241ULL, 0x282442ce18f0d309ULL, 0x15f8d9eb075340b9ULL,
+        0x2b3bde04ad448b4cULL, 0x3b8e7117fda6bc40ULL, 0x16d5239e22ead7c0ULL, 0x190dfc7d1cbfd7e8ULL,
+        0x25e9c020a5b85912ULL, 0x1b5f66f9e6bccf35ULL, 0x054b6334e6e3fa59ULL, 0x02a44ab91f20241eULL,
+        0x27658d0c20a2be65ULL, 0x14c2ea7c8d230119ULL, 0x1d464ae958b0ce62ULL, 0x3eba6e2017b0e9c5ULL,
+        0x21a082edbc0fa1b1ULL, 0x050e710383b3b2f2ULL, 0x1cea8a706c56c9caULL, 0x3a8258d823bf32f8ULL,
+        0x0c06298e7ba54837ULL, 0x06ac3a412a641cc6ULL, 0x31f9c475359b4c37ULL, 0x0c787ec4b7c2ffe9ULL,
+        0x274fc88629ddb2ccULL, 0x100c8d23cb0af097ULL, 0x191dec912bead373ULL, 0x24cf4780e346d450ULL,
+        0x3ad2b5db060ed2d6ULL, 0x0d1f9c8b80daa9e6ULL, 0x3b6587864d606138ULL, 0x3bc109eef2be65d6ULL,
+        0x1ffcbaed8c1645eeULL, 0x254f5970484a5c6dULL, 0x3bf204b3c7df245aULL, 0x086c2f2594a7c281ULL,
+        0x23799849840d344eULL, 0x1c4857ac16c604d7ULL, 0x32988dee9096fe50ULL, 0x1c29f37405851e29ULL,
+        0x3f3d8eaf0ff68bdcULL, 0x31428cfd7c45c0e9ULL, 0x11c3523fb7eac0dbULL, 0x104a1718e0905166ULL,
+        0x19bf93181cb5b892ULL, 0x34318d592118c00aULL, 0x06f2bf3a179319e2ULL, 0x3aae93c16c21784aULL,
+        0x19f02f676d66e28fULL, 0x2351d4619b963c56ULL, 0x34dc0fc42892c837ULL, 0x25db18b194303886ULL,
+        0x39a8b7a2f8524fe3ULL, 0x29026d590552a3d2ULL, 0x28bce1f84ab61760ULL, 0x2ced46d1ea94bfcfULL,
+        0x0391869a05ac6650ULL, 0x0c58d257d1894670ULL, 0x1943ebf5a28795d2ULL, 0x2d86e8d924423228ULL,
+        0x32f42572cc3d38e7ULL, 0x2b89d21922ca4332ULL, 0x08db6c9a87ac11edULL, 0x2dd7d5d408c5a382ULL,
+    },
+    { // 10
+        0x129763c303f74405ULL, 0x3793dbd4292caf35ULL, 0x3d0d1acefb1ad9b0ULL, 0x3beb2e4a13b57324ULL,
+        0x10d394a44e774d6bULL, 0x0e0b06a57a4599c0ULL, 0x127cbc868dcdb200ULL, 0x2078c3e0d9b86c19ULL,
+        0x356a1d6dd78dc56eULL, 0x38f204fc48796619ULL, 0x371828dde3ff9839ULL, 0x12d4303e21910b85ULL,
+        0x25b062b888d56115ULL, 0x31866fd44898031eULL, 0x0680ed4f694ce5ccULL, 0x1a64db7048511286ULL,
+        0x03dfdc566189e616ULL, 0x2f85cb2958d2438aULL, 0x2d2544da5e91b511ULL, 0x1355c783d38705acULL,
+        0x121134f7e96f0177ULL, 0x32c07f6a5ed767c5ULL, 0x1a1847f6f094008aULL, 0x0d5973f6bd011998ULL,
+        0x2453609f81c87342ULL, 0x11484f1051ad0317ULL, 0x0c73d974a7ee5caeULL, 0x176340061c22ccfeULL,
+        0x3828c67d5d31f099ULL, 0x33bba5b0f444283aULL, 0x137cb6bee86b69f4ULL, 0x21e40f297d98886aULL,
+        0x202c820cb2690593ULL, 0x0eb124614f0c4e5bULL, 0x29ad024be6062dbeULL, 0x274d62b438a34185ULL,
+        0x10483b1e6f5cd0baULL, 0x3efadf2e65d64d38ULL, 0x2cea9343ddf772c7ULL, 0x1f1d52d14fc7c57eULL,
+        0x2be8393d212286a0ULL, 0x2a5afa3cec82d424ULL, 0x1cd4de96dc2fd5e8ULL, 0x19c5a4c10933be5dULL,
+        0x3fe877e5739b8dc9ULL, 0x06c7098bde4df680ULL, 0x238a1567334e497eULL, 0x3c2943a3ef4e598aULL,
+        0x231e4966da8ab793ULL, 0x0bddc05b12f6350bULL, 0x08b52425877d7b0bULL, 0x18e8b13648168f92ULL,
+        0x2fb4b9407b04601fULL, 0x3061dae301883ec8ULL, 0x2f0df4ccc614b0a7ULL, 0x1e0d3dc0e3f6b1c2ULL,
+        0x09f8b46bcc22c444ULL, 0x253530023296f0faULL, 0x32e7e59cd743dc20ULL, 0x1a1fc1b22f5170e3ULL,
+        0x0951695d8a68ac1eULL, 0x22c7bf69a79f7120ULL, 0x14106ea755ffbc9dULL, 0x05f04fa643b7d2feULL,
+    },
+    { // 11
+        0x0316379ee37e3f83ULL, 0x1e1d99bbfcce0933ULL, 0x0c127e92f4ac7b41ULL, 0x0d8d92f736342b1aULL,
+        0x23bedecc57eecee5ULL, 0x30876b384a016190ULL, 0x0629437203258e8eULL, 0x264f718a474f9036ULL,
+        0x37be1350b2d93e94ULL, 0x02a4ec9ae060d133ULL, 0x03be21a7232b98c4ULL, 0x1e6872488dc5eba1ULL,
+        0x394a6256a8640275ULL, 0x389c48044d7504d1ULL, 0x3a85aa3176cbe6fdULL, 0x34c26377bd4b33f3ULL,
+        0x06d0dcb9f49bc849ULL, 0x24f14cc9de2dce7eULL, 0x020b49a58258baacULL, 0x39780fd07f26d244ULL,
+        0x3b64bdc869ac3f25ULL, 0x11851aa6c1061cafULL, 0x026e7c1bb850b3f0ULL, 0x244e6b68225ab0b6ULL,
+        0x32bf87ad5faea19dULL, 0x0121d1d76a256af2ULL, 0x0cd5d4cad7f69d38ULL, 0x174e4406256ccaa9ULL,
+        0x11288ac94c588fd1ULL, 0x307692dd3aaaae9aULL, 0x3d5b122ef81d77f4ULL, 0x079359976c2cf237ULL,
+        0x0fd80ddc84d379fcULL, 0x19f5f22e3a26061aULL, 0x0f4320e12e1469f4ULL, 0x0d33476234540434ULL,
+        0x21459afb4c1c58d7ULL, 0x35b058ca261c92c6ULL, 0x0b3df43bf1655aa9ULL, 0x3aabe0ca55528d70ULL,
+        0x1d0d232cfdb83db9ULL, 0x306bd60e4b4a80a9ULL, 0x3c196968e7e79f00ULL, 0x0211c4fb89160a10ULL,
+        0x1deb330d42c1a441ULL, 0x283be4354af5e55eULL, 0x2e4c9cce02e07909ULL, 0x2486d047c8a9cdd0ULL,
+        0x0cfaf5bdc43cd752ULL, 0x387746aa6eb70712ULL, 0x020279f8158f67b4ULL, 0x096bd461af13a208ULL,
+        0x0aded2105baa71e0ULL, 0x0a941caf2047d1edULL, 0x1e5ff58c687b8ac3ULL, 0x068739a6d91c86efULL,
+        0x1ff833e6f3e8b98dULL, 0x167e5884c248bf21ULL, 0x0aa5b0dd736f2f6bULL, 0x24eea9da298a287eULL,
+        0x1c258446506d5d97ULL, 0x1b45fea33370ddd4ULL, 0x2dcf557a957b7278ULL, 0x1b509870ce878e63ULL,
+    }
+};
+
+const U64 POS::msZobCastle[16] = {
+    0x0acd17b339b1b2cfULL, 0x182553bfdbae6dfeULL, 0x1741e65f31b8dcb6ULL, 0x14964be29918da2fULL,
+    0x19a06087bc8ab270ULL, 0x0f3a082d96eabdfdULL, 0x2e28997abb57ccb5ULL, 0x1fc05e63478055e0ULL,
+    0x061fa6d9317e9235ULL, 0x30ce0a05c311fc12ULL, 0x0597ebdf09fcd438ULL, 0x118801e50a54e80aULL,
+    0x2a3dee9721f1d4a7ULL, 0x25c49c558031b432ULL, 0x214952b77e6ed225ULL, 0x183302c9d179a056ULL
+};
+
+const U64 POS::msZobEp[8] = {
+    0x35c7a60eee3a533dULL, 0x0696e16486cf39faULL, 0x02f362fb3bfeebe4ULL, 0x29d782ba1ddcb347ULL,
+    0x3d09244394286bf9ULL, 0x10fc258ec100dff1ULL, 0x2412072e5a8db24dULL, 0x2fcb2cbd4230dd48ULL
+};